@@ -194,6 +194,33 @@ class AutoDriver:
         """
         return self.bridge.get_path_length(from_loc, to_loc, self.player_index)
 
+    def find_nearest_by_path_length(self, from_loc: unreal.Vector,
+                                    targets: List[unreal.Vector]) -> Tuple[int, float]:
+        """Find the target with the shortest path, using one navigation search for all targets
+
+        Args:
+            from_loc: Start location
+            targets: Candidate target locations
+
+        Returns:
+            (index into targets, path length), or (-1, -1.0) if no target is reachable
+        """
+        return self.bridge.find_nearest_by_path_length(from_loc, targets, self.player_index)
+
+    def estimate_path_length(self, from_loc: unreal.Vector, to_loc: unreal.Vector,
+                             refine: bool = False) -> float:
+        """Estimate path length between two locations without a full path search
+
+        Args:
+            from_loc: Start location
+            to_loc: End location
+            refine: Expand the estimate into a real path for the exact length
+
+        Returns:
+            Path length in units (-1 if unreachable)
+        """
+        return self.bridge.estimate_path_length(from_loc, to_loc, refine, self.player_index)
+
     def get_random_location(self, origin: unreal.Vector, radius: float = 1000.0) -> unreal.Vector:
         """Get random reachable location
 
@@ -39,6 +39,59 @@ def test_get_path_length(autodriver):
             f"Path length {path_length} seems too short for straight distance {straight_distance}"
 
 
+@pytest.mark.navigation
+def test_find_nearest_by_path_length(autodriver):
+    """Test picking the nearest target by path length"""
+    current = autodriver.location
+    targets = [
+        unreal.Vector(current.x + 900, current.y, current.z),
+        unreal.Vector(current.x + 300, current.y, current.z),
+        unreal.Vector(current.x, current.y + 600, current.z),
+    ]
+
+    index, path_length = autodriver.find_nearest_by_path_length(current, targets)
+
+    if index >= 0:  # If any target is reachable
+        assert index < len(targets), f"Index {index} out of range"
+        assert path_length == pytest.approx(autodriver.get_path_length(current, targets[index]), rel=0.01), \
+            "Reported length should match a direct path length query"
+
+        # The pick must be exactly the shortest reachable target
+        lengths = [autodriver.get_path_length(current, other) for other in targets]
+        shortest = min(length for length in lengths if length > 0)
+        assert lengths[index] == shortest, \
+            f"Picked target at {lengths[index]}, but another is at {shortest}"
+    else:
+        assert path_length < 0, "Unreachable result should report a negative length"
+
+    # No candidates: nothing to pick
+    empty_index, _ = autodriver.find_nearest_by_path_length(current, [])
+    assert empty_index == -1, "Empty candidate list should return -1"
+
+
+@pytest.mark.navigation
+def test_estimate_path_length(autodriver):
+    """Test path length estimates against exact path lengths"""
+    current = autodriver.location
+    target = unreal.Vector(current.x + 1500, current.y + 500, current.z)
+
+    estimate = autodriver.estimate_path_length(current, target)
+    refined = autodriver.estimate_path_length(current, target, refine=True)
+    exact = autodriver.get_path_length(current, target)
+
+    if exact > 0:  # If path exists
+        assert estimate > 0, "Reachable target should have an estimate"
+        assert refined > 0, "Reachable target should have a refined length"
+
+        straight_distance = unreal.Vector.distance(current, target)
+        assert estimate >= straight_distance * 0.9, \
+            f"Estimate {estimate} shorter than straight distance {straight_distance}"
+        assert refined <= estimate * 1.01, \
+            f"Refined length {refined} should not exceed the estimate {estimate}"
+    else:
+        assert estimate < 0, "Unreachable target should report a negative estimate"
+
+
 @pytest.mark.navigation
 def test_get_random_location(autodriver):
     """Test getting random reachable locations"""
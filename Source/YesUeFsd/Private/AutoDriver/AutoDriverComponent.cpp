@@ -4,6 +4,7 @@
 #include "AutoDriver/Commands/IAutoDriverCommand.h"
 #include "AutoDriver/WidgetQueryHelper.h"
 #include "AutoDriver/UIInteractionHelper.h"
+#include "AutoDriver/NavigationHelper.h"
 #include "GameFramework/PlayerController.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
@@ -342,87 +343,48 @@ void UAutoDriverComponent::ReleaseAIController()
 
 bool UAutoDriverComponent::IsLocationReachable(FVector TargetLocation)
 {
-	APawn* Pawn = GetControlledPawn();
-	if (!Pawn)
-	{
-		return false;
-	}
-
-	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
-	if (!NavSys)
-	{
-		return false;
-	}
-
-	FPathFindingQuery Query;
-	Query.StartLocation = Pawn->GetActorLocation();
-	Query.EndLocation = TargetLocation;
-	Query.NavData = NavSys->GetDefaultNavDataInstance();
-
-	if (!Query.NavData.IsValid())
-	{
-		return false;
-	}
-
-	FPathFindingResult Result = NavSys->FindPathSync(Query);
-	return Result.IsSuccessful() && Result.Path.IsValid();
+	return FindPathToLocation(TargetLocation).IsValid();
 }
 
 float UAutoDriverComponent::GetPathLengthToLocation(FVector TargetLocation)
+{
+	FNavPathSharedPtr Path = FindPathToLocation(TargetLocation);
+	return Path.IsValid() ? Path->GetLength() : -1.0f;
+}
+
+bool UAutoDriverComponent::GetRandomReachableLocation(float Radius, FVector& OutLocation)
 {
 	APawn* Pawn = GetControlledPawn();
 	if (!Pawn)
 	{
-		return -1.0f;
-	}
-
-	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
-	if (!NavSys)
-	{
-		return -1.0f;
-	}
-
-	FPathFindingQuery Query;
-	Query.StartLocation = Pawn->GetActorLocation();
-	Query.EndLocation = TargetLocation;
-	Query.NavData = NavSys->GetDefaultNavDataInstance();
-
-	if (!Query.NavData.IsValid())
-	{
-		return -1.0f;
+		return false;
 	}
 
-	FPathFindingResult Result = NavSys->FindPathSync(Query);
-	if (Result.IsSuccessful() && Result.Path.IsValid())
+	const FNavigationQueryResult Result = UNavigationHelper::GetRandomReachableLocation(this, Pawn->GetActorLocation(), Radius);
+	if (Result.bSuccess)
 	{
-		return Result.Path->GetLength();
+		OutLocation = Result.Location;
 	}
-
-	return -1.0f;
+	return Result.bSuccess;
 }
 
-bool UAutoDriverComponent::GetRandomReachableLocation(float Radius, FVector& OutLocation)
+FNavPathSharedPtr UAutoDriverComponent::FindPathToLocation(const FVector& TargetLocation)
 {
 	APawn* Pawn = GetControlledPawn();
 	if (!Pawn)
 	{
-		return false;
+		return nullptr;
 	}
 
 	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
 	if (!NavSys)
 	{
-		return false;
-	}
-
-	FNavLocation NavLocation;
-	if (NavSys->GetRandomReachablePointInRadius(Pawn->GetActorLocation(), Radius, NavLocation))
-	{
-		OutLocation = NavLocation.Location;
-		return true;
+		return nullptr;
 	}
 
-	return false;
+	// Same navigation data (and default filter) as UMoveToLocationCommand, so both share cache entries
+	const ANavigationData* NavData = NavSys->GetNavDataForProps(Pawn->GetNavAgentPropertiesRef(), Pawn->GetNavAgentLocation());
+	return UNavigationHelper::FindPath(this, Pawn->GetActorLocation(), TargetLocation, NavData);
 }
 
 // ========================================
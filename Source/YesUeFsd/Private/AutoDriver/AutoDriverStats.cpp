@@ -11,10 +11,23 @@ DEFINE_STAT(STAT_AutoDriver_ActiveCommands);
 
 // Navigation
 DEFINE_STAT(STAT_AutoDriver_NavigationQuery);
+DEFINE_STAT(STAT_AutoDriver_NavQueriesCoalesced);
 DEFINE_STAT(STAT_AutoDriver_PathFinding);
 DEFINE_STAT(STAT_AutoDriver_NavCacheHits);
 DEFINE_STAT(STAT_AutoDriver_NavCacheMisses);
 DEFINE_STAT(STAT_AutoDriver_NavCacheEntries);
+DEFINE_STAT(STAT_AutoDriver_NavCacheInvalidations);
+DEFINE_STAT(STAT_AutoDriver_NavIslandRejections);
+DEFINE_STAT(STAT_AutoDriver_NavCacheSuffixHits);
+DEFINE_STAT(STAT_AutoDriver_NavGoalTreeHits);
+DEFINE_STAT(STAT_AutoDriver_NavGoalTreeBuild);
+DEFINE_STAT(STAT_AutoDriver_NavPointPoolHits);
+DEFINE_STAT(STAT_AutoDriver_NavPointPoolRefill);
+DEFINE_STAT(STAT_AutoDriver_NavClusterQueries);
+DEFINE_STAT(STAT_AutoDriver_NavClusterGraphBuild);
+DEFINE_STAT(STAT_AutoDriver_NavTimeSlicedRequests);
+DEFINE_STAT(STAT_AutoDriver_NavTimeSlicedSearch);
+DEFINE_STAT(STAT_AutoDriver_NavDebugItems);
 
 // AI Controllers
 DEFINE_STAT(STAT_AutoDriver_AIControllersCreated);
@@ -2,6 +2,8 @@
 
 #include "AutoDriver/Commands/MoveToLocationCommand.h"
 #include "AutoDriver/AutoDriverStats.h"
+#include "AutoDriver/NavigationHelper.h"
+#include "AutoDriver/NavPathScheduler.h"
 #include "GameFramework/PlayerController.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
@@ -9,6 +11,7 @@
 #include "Navigation/PathFollowingComponent.h"
 #include "NavigationSystem.h"
 #include "NavigationPath.h"
+#include "NavMesh/RecastNavMesh.h"
 
 void UMoveToLocationCommand::Initialize_Implementation(UObject* InContext)
 {
@@ -91,6 +94,7 @@ void UMoveToLocationCommand::Tick_Implementation(float DeltaTime)
 		Result = FAutoDriverCommandResult(EAutoDriverCommandStatus::Failed,
 			FString::Printf(TEXT("Movement timed out after %.1f seconds"), ExecutionTime));
 		bIsRunning = false;
+		ReleasePathRequest();
 		UE_LOG(LogTemp, Warning, TEXT("MoveToLocationCommand: Timed out"));
 		return;
 	}
@@ -102,10 +106,20 @@ void UMoveToLocationCommand::Tick_Implementation(float DeltaTime)
 			FString::Printf(TEXT("Reached target in %.2f seconds"), ExecutionTime));
 		Result.ExecutionTime = ExecutionTime;
 		bIsRunning = false;
+		ReleasePathRequest();
 		UE_LOG(LogTemp, Log, TEXT("MoveToLocationCommand: Completed successfully"));
 		return;
 	}
 
+	// Time-sliced path still being solved
+	if (PathRequestId != INDEX_NONE && !UpdatePathRequest())
+	{
+		Result = FAutoDriverCommandResult(EAutoDriverCommandStatus::Failed, TEXT("Could not start navigation movement"));
+		bIsRunning = false;
+		UE_LOG(LogTemp, Warning, TEXT("MoveToLocationCommand: Could not start navigation movement"));
+		return;
+	}
+
 	// For direct movement mode, continuously update movement direction
 	if (MovementMode == EAutoDriverMovementMode::Direct)
 	{
@@ -126,6 +140,7 @@ void UMoveToLocationCommand::Cancel_Implementation()
 
 	bIsRunning = false;
 	Result = FAutoDriverCommandResult(EAutoDriverCommandStatus::Cancelled, TEXT("Movement cancelled"));
+	ReleasePathRequest();
 
 	// Stop character movement
 	if (Character && Character->GetCharacterMovement())
@@ -228,8 +243,142 @@ bool UMoveToLocationCommand::ExecuteNavigationMovement()
 		return ExecuteDirectMovement();
 	}
 
+	NavigationController = AIController;
+	bFollowingPartialPath = false;
+	bReplannedFromPartial = false;
+	ReleasePathRequest();
+
+	// Query the navigation data and filter this agent actually moves on so cached entries match
+	const ANavigationData* AgentNavData = GetAgentNavData();
+	const TSubclassOf<UNavigationQueryFilter> FilterClass = AIController->GetDefaultNavigationFilterClass();
+
+	// Long paths are solved over the next frames; movement starts on the first partial path
+	if (bTimeSlicedPathfinding)
+	{
+		PathRequestId = UNavigationHelper::RequestPathTimeSliced(World, Character->GetActorLocation(), TargetLocation, PathPriority, AgentNavData, FilterClass);
+		if (PathRequestId != INDEX_NONE)
+		{
+			return UpdatePathRequest();
+		}
+	}
+
+	// Follow cached path geometry when available to skip another FindPathSync
+	FNavPathSharedPtr CachedPath = UNavigationHelper::FindPath(World, Character->GetActorLocation(), TargetLocation, AgentNavData, FilterClass);
+	if (CachedPath.IsValid() && RequestPathMove(CachedPath, false))
+	{
+		UE_LOG(LogTemp, Log, TEXT("MoveToLocationCommand: Navigation movement started (cached path)"));
+		return true;
+	}
+
+	return RequestControllerMove();
+}
+
+bool UMoveToLocationCommand::UpdatePathRequest()
+{
+	FNavPathSharedPtr Path;
+	switch (UNavigationHelper::PollPathRequest(PlayerController, PathRequestId, Path))
+	{
+		case ENavPathRequestStatus::Pending:
+			return true;
+
+		case ENavPathRequestStatus::Partial:
+			// Partial paths start where the request started, so only the first one is followed
+			if (!bFollowingPartialPath && RequestPathMove(Path, true))
+			{
+				bFollowingPartialPath = true;
+				UE_LOG(LogTemp, Log, TEXT("MoveToLocationCommand: Navigation movement started (partial path)"));
+			}
+			return true;
+
+		case ENavPathRequestStatus::Complete:
+			PathRequestId = INDEX_NONE;
+
+			// The character has moved along the partial path: re-plan once from here, which the
+			// cache usually answers with the remainder of the full path just solved
+			if (bFollowingPartialPath && !bReplannedFromPartial)
+			{
+				bReplannedFromPartial = true;
+				PathRequestId = UNavigationHelper::RequestPathTimeSliced(PlayerController, Character->GetActorLocation(), TargetLocation,
+					PathPriority, GetAgentNavData(), NavigationController->GetDefaultNavigationFilterClass());
+				if (PathRequestId != INDEX_NONE)
+				{
+					return UpdatePathRequest();
+				}
+			}
+
+			if (RequestPathMove(Path, false))
+			{
+				UE_LOG(LogTemp, Log, TEXT("MoveToLocationCommand: Navigation movement started (time-sliced path)"));
+				return true;
+			}
+			return RequestControllerMove();
+
+		default:
+			PathRequestId = INDEX_NONE;
+			return RequestControllerMove();
+	}
+}
+
+void UMoveToLocationCommand::ReleasePathRequest()
+{
+	if (PathRequestId != INDEX_NONE)
+	{
+		UNavigationHelper::CancelPathRequest(PlayerController, PathRequestId);
+		PathRequestId = INDEX_NONE;
+	}
+}
+
+bool UMoveToLocationCommand::RequestPathMove(FNavPathSharedPtr Path, bool bPartial)
+{
+	if (!NavigationController || !Path.IsValid())
+	{
+		return false;
+	}
+
+	FAIMoveRequest MoveRequest(TargetLocation);
+	MoveRequest.SetNavigationFilter(NavigationController->GetDefaultNavigationFilterClass());
+	MoveRequest.SetAcceptanceRadius(AcceptanceRadius);
+	MoveRequest.SetReachTestIncludesAgentRadius(true);
+	MoveRequest.SetUsePathfinding(true);
+	MoveRequest.SetAllowPartialPath(bPartial);
+	MoveRequest.SetProjectGoalLocation(true);
+
+	// Path following repaths and updates its path in place, so it gets its own copy and the
+	// (possibly cache-owned) instance stays untouched
+	FNavPathSharedPtr MovePath;
+#if WITH_RECAST
+	if (const FNavMeshPath* NavMeshPath = Path->CastPath<FNavMeshPath>())
+	{
+		TSharedRef<FNavMeshPath, ESPMode::ThreadSafe> Copy = MakeShared<FNavMeshPath, ESPMode::ThreadSafe>();
+		Copy->PathCorridor = NavMeshPath->PathCorridor;
+		Copy->PathCorridorCost = NavMeshPath->PathCorridorCost;
+		MovePath = Copy;
+	}
+	else
+#endif
+	{
+		MovePath = MakeShared<FNavigationPath, ESPMode::ThreadSafe>();
+	}
+
+	MovePath->GetPathPoints() = Path->GetPathPoints();
+	MovePath->SetNavigationDataUsed(Path->GetNavigationDataUsed());
+	MovePath->SetQueryData(Path->GetQueryData());
+	MovePath->SetIsPartial(Path->IsPartial());
+	MovePath->MarkReady();
+
+	return NavigationController->RequestMove(MoveRequest, MovePath).IsValid();
+}
+
+bool UMoveToLocationCommand::RequestControllerMove()
+{
+	if (!NavigationController)
+	{
+		MovementMode = EAutoDriverMovementMode::Direct;
+		return ExecuteDirectMovement();
+	}
+
 	// Use AI MoveTo for navigation
-	EPathFollowingRequestResult::Type MoveResult = AIController->MoveToLocation(
+	EPathFollowingRequestResult::Type MoveResult = NavigationController->MoveToLocation(
 		TargetLocation,
 		AcceptanceRadius,
 		true,  // Stop on overlap
@@ -253,6 +402,14 @@ bool UMoveToLocationCommand::ExecuteNavigationMovement()
 	}
 }
 
+const ANavigationData* UMoveToLocationCommand::GetAgentNavData() const
+{
+	UNavigationSystemV1* NavSys = Character ? FNavigationSystem::GetCurrent<UNavigationSystemV1>(Character->GetWorld()) : nullptr;
+	return NavSys
+		? NavSys->GetNavDataForProps(Character->GetNavAgentPropertiesRef(), Character->GetNavAgentLocation())
+		: nullptr;
+}
+
 bool UMoveToLocationCommand::ExecuteDirectMovement()
 {
 	if (!Character || !Character->GetCharacterMovement())
@@ -0,0 +1,445 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AutoDriver/NavClusterGraph.h"
+#include "AutoDriver/NavMeshPolyGraph.h"
+#include "AutoDriver/AutoDriverStats.h"
+#include "Algo/Reverse.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	/** Cluster seeds, clusters or entrances processed between clock checks */
+	constexpr int32 ItemsPerClockCheck = 16;
+
+	/** Open-list entry of a search inside one cluster */
+	struct FClusterQueueItem
+	{
+		float Cost;
+		int32 Node;
+
+		bool operator<(const FClusterQueueItem& Other) const { return Cost < Other.Cost; }
+	};
+
+	/** Open-list entry of the entrance graph search */
+	struct FEntranceQueueItem
+	{
+		/** Cost so far plus straight-line distance to the goal; exact for final items */
+		float Key;
+		float Cost;
+		/** Entrance reached, or (final items) the last entrance before the goal leg; INDEX_NONE for the in-cluster route */
+		int32 Entrance;
+		/** Complete route to the goal; popping one ends the search */
+		bool bFinal;
+
+		bool operator<(const FEntranceQueueItem& Other) const { return Key < Other.Key; }
+	};
+}
+
+FNavClusterGraph::FNavClusterGraph(const FNavMeshPolyGraph& Graph, float ClusterSize)
+	: GraphVersion(Graph.GetVersion())
+	, NumGraphNodes(Graph.GetNumNodes())
+	, CellSize(FMath::Max(ClusterSize, 100.0f))
+{
+}
+
+bool FNavClusterGraph::Build(const FNavMeshPolyGraph& Graph, double Deadline)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AutoDriver_NavClusterGraphBuild);
+
+	int32 Steps = 0;
+	auto IsOutOfTime = [&Steps, Deadline]()
+	{
+		return ++Steps % ItemsPerClockCheck == 0 && FPlatformTime::Seconds() >= Deadline;
+	};
+
+	if (Phase == EBuildPhase::Clusters)
+	{
+		if (NodeCells.Num() != NumGraphNodes)
+		{
+			NodeCells.SetNumUninitialized(NumGraphNodes);
+			for (int32 Node = 0; Node < NumGraphNodes; ++Node)
+			{
+				const FVector& Center = Graph.GetNodeCenter(Node);
+				NodeCells[Node] = FIntPoint(FMath::FloorToInt32(Center.X / CellSize), FMath::FloorToInt32(Center.Y / CellSize));
+			}
+
+			NodeClusters.Init(INDEX_NONE, NumGraphNodes);
+			ClusterNodes.Reserve(NumGraphNodes);
+		}
+
+		// Clusters: connected pieces of each cell, ignoring edge direction, so floors stacked in one cell stay apart
+		TArray<int32> Stack;
+		for (; NextItem < NumGraphNodes; ++NextItem)
+		{
+			const int32 Seed = NextItem;
+			if (NodeClusters[Seed] != INDEX_NONE)
+			{
+				continue;
+			}
+
+			if (IsOutOfTime())
+			{
+				return false;
+			}
+
+			const int32 Cluster = ClusterNodeOffsets.Add(ClusterNodes.Num());
+			NodeClusters[Seed] = Cluster;
+			Stack.Add(Seed);
+
+			while (Stack.Num() > 0)
+			{
+				const int32 Node = Stack.Pop(EAllowShrinking::No);
+				ClusterNodes.Add(Node);
+
+				auto Visit = [&](int32 Other)
+				{
+					if (NodeClusters[Other] == INDEX_NONE && NodeCells[Other] == NodeCells[Node])
+					{
+						NodeClusters[Other] = Cluster;
+						Stack.Add(Other);
+					}
+				};
+
+				for (const int32 Next : Graph.GetNeighbors(Node))
+				{
+					Visit(Next);
+				}
+				for (const int32 Previous : Graph.GetIncoming(Node))
+				{
+					Visit(Previous);
+				}
+			}
+		}
+		ClusterNodeOffsets.Add(ClusterNodes.Num());
+		NodeCells.Empty();
+
+		NodeEntrances.Init(INDEX_NONE, NumGraphNodes);
+		ClusterEntranceOffsets.Reserve(GetNumClusters() + 1);
+		Phase = EBuildPhase::Entrances;
+		NextItem = 0;
+	}
+
+	if (Phase == EBuildPhase::Entrances)
+	{
+		// Entrances: polygons with an edge into or out of their cluster
+		for (; NextItem < GetNumClusters(); ++NextItem)
+		{
+			if (IsOutOfTime())
+			{
+				return false;
+			}
+
+			const int32 Cluster = NextItem;
+			ClusterEntranceOffsets.Add(ClusterEntrances.Num());
+
+			for (int32 Index = ClusterNodeOffsets[Cluster]; Index < ClusterNodeOffsets[Cluster + 1]; ++Index)
+			{
+				const int32 Node = ClusterNodes[Index];
+
+				bool bEntrance = false;
+				for (const int32 Next : Graph.GetNeighbors(Node))
+				{
+					bEntrance |= NodeClusters[Next] != Cluster;
+				}
+				for (const int32 Previous : Graph.GetIncoming(Node))
+				{
+					bEntrance |= NodeClusters[Previous] != Cluster;
+				}
+
+				if (bEntrance)
+				{
+					NodeEntrances[Node] = EntranceNodes.Add(Node);
+					ClusterEntrances.Add(NodeEntrances[Node]);
+				}
+			}
+		}
+		ClusterEntranceOffsets.Add(ClusterEntrances.Num());
+
+		EdgeOffsets.Reserve(EntranceNodes.Num() + 1);
+		Phase = EBuildPhase::Edges;
+		NextItem = 0;
+	}
+
+	if (Phase == EBuildPhase::Edges)
+	{
+		// Entrance graph: shortest in-cluster distances to the other entrances, plus the edges leaving the cluster
+		TMap<int32, FLocalRecord> Records;
+		for (; NextItem < EntranceNodes.Num(); ++NextItem)
+		{
+			if (IsOutOfTime())
+			{
+				return false;
+			}
+
+			const int32 Entrance = NextItem;
+			EdgeOffsets.Add(EdgeTargets.Num());
+
+			const int32 Node = EntranceNodes[Entrance];
+			const int32 Cluster = NodeClusters[Node];
+
+			SearchCluster(Graph, Node, false, Records);
+			for (int32 Index = ClusterEntranceOffsets[Cluster]; Index < ClusterEntranceOffsets[Cluster + 1]; ++Index)
+			{
+				const int32 Other = ClusterEntrances[Index];
+				const FLocalRecord* Record = Other != Entrance ? Records.Find(EntranceNodes[Other]) : nullptr;
+				if (Record)
+				{
+					EdgeTargets.Add(Other);
+					EdgeCosts.Add(Record->Cost);
+				}
+			}
+
+			const TArrayView<const int32> Neighbors = Graph.GetNeighbors(Node);
+			const TArrayView<const float> Costs = Graph.GetEdgeCosts(Node);
+			for (int32 i = 0; i < Neighbors.Num(); ++i)
+			{
+				if (NodeClusters[Neighbors[i]] != Cluster)
+				{
+					EdgeTargets.Add(NodeEntrances[Neighbors[i]]);
+					EdgeCosts.Add(Costs[i]);
+				}
+			}
+		}
+		EdgeOffsets.Add(EdgeTargets.Num());
+
+		Phase = EBuildPhase::Complete;
+		NextItem = 0;
+	}
+
+	return true;
+}
+
+bool FNavClusterGraph::IsValidFor(const FNavMeshPolyGraph& Graph) const
+{
+	return GraphVersion == Graph.GetVersion() && NumGraphNodes == Graph.GetNumNodes();
+}
+
+bool FNavClusterGraph::FindDistance(const FNavMeshPolyGraph& Graph, int32 StartNode, int32 GoalNode, float& OutDistance, TArray<int32>* OutCorridor) const
+{
+	OutDistance = 0.0f;
+	if (OutCorridor)
+	{
+		OutCorridor->Reset();
+	}
+
+	if (!IsComplete() || !NodeClusters.IsValidIndex(StartNode) || !NodeClusters.IsValidIndex(GoalNode)
+		|| Graph.GetComponent(StartNode) != Graph.GetComponent(GoalNode))
+	{
+		return false;
+	}
+
+	if (StartNode == GoalNode)
+	{
+		if (OutCorridor)
+		{
+			OutCorridor->Add(StartNode);
+		}
+		return true;
+	}
+
+	const int32 StartCluster = NodeClusters[StartNode];
+	const int32 GoalCluster = NodeClusters[GoalNode];
+
+	// Polygon-level searches only in the end clusters: out to the start's entrances, in from the goal's
+	TMap<int32, FLocalRecord> StartRecords;
+	TMap<int32, FLocalRecord> GoalRecords;
+	SearchCluster(Graph, StartNode, false, StartRecords);
+	SearchCluster(Graph, GoalNode, true, GoalRecords);
+
+	const FVector& GoalCenter = Graph.GetNodeCenter(GoalNode);
+
+	TArray<FEntranceQueueItem> Open;
+	TMap<int32, FLocalRecord> Records;
+
+	// Route that never leaves a shared cluster; a route through other clusters may still be shorter
+	if (StartCluster == GoalCluster)
+	{
+		if (const FLocalRecord* Direct = StartRecords.Find(GoalNode))
+		{
+			Open.HeapPush({ Direct->Cost, Direct->Cost, INDEX_NONE, true });
+		}
+	}
+
+	for (int32 Index = ClusterEntranceOffsets[StartCluster]; Index < ClusterEntranceOffsets[StartCluster + 1]; ++Index)
+	{
+		const int32 Entrance = ClusterEntrances[Index];
+		if (const FLocalRecord* Record = StartRecords.Find(EntranceNodes[Entrance]))
+		{
+			Records.Add(Entrance, { Record->Cost, INDEX_NONE });
+			Open.HeapPush({ Record->Cost + FVector::Dist(Graph.GetNodeCenter(EntranceNodes[Entrance]), GoalCenter), Record->Cost, Entrance, false });
+		}
+	}
+
+	while (Open.Num() > 0)
+	{
+		FEntranceQueueItem Item;
+		Open.HeapPop(Item, EAllowShrinking::No);
+
+		if (Item.bFinal)
+		{
+			OutDistance = Item.Cost;
+			if (!OutCorridor)
+			{
+				return true;
+			}
+
+			// Refine: expand the entrance route one cluster at a time
+			TArray<int32>& Corridor = *OutCorridor;
+			Corridor.Add(StartNode);
+
+			if (Item.Entrance == INDEX_NONE)
+			{
+				AppendForward(StartRecords, GoalNode, Corridor);
+				return true;
+			}
+
+			TArray<int32> Route;
+			for (int32 Entrance = Item.Entrance; Entrance != INDEX_NONE; Entrance = Records.FindChecked(Entrance).Link)
+			{
+				Route.Add(Entrance);
+			}
+			Algo::Reverse(Route);
+
+			AppendForward(StartRecords, EntranceNodes[Route[0]], Corridor);
+
+			TMap<int32, FLocalRecord> LocalRecords;
+			for (int32 i = 1; i < Route.Num(); ++i)
+			{
+				const int32 From = EntranceNodes[Route[i - 1]];
+				const int32 To = EntranceNodes[Route[i]];
+				if (NodeClusters[From] == NodeClusters[To])
+				{
+					SearchCluster(Graph, From, false, LocalRecords);
+					AppendForward(LocalRecords, To, Corridor);
+				}
+				else
+				{
+					Corridor.Add(To);
+				}
+			}
+
+			for (int32 Node = GoalRecords.FindChecked(EntranceNodes[Route.Last()]).Link; Node != INDEX_NONE; Node = GoalRecords.FindChecked(Node).Link)
+			{
+				Corridor.Add(Node);
+			}
+			return true;
+		}
+
+		// Stale entry left behind by a later relaxation
+		if (Item.Cost > Records.FindChecked(Item.Entrance).Cost)
+		{
+			continue;
+		}
+
+		const int32 Node = EntranceNodes[Item.Entrance];
+		if (NodeClusters[Node] == GoalCluster)
+		{
+			if (const FLocalRecord* GoalRecord = GoalRecords.Find(Node))
+			{
+				const float Cost = Item.Cost + GoalRecord->Cost;
+				Open.HeapPush({ Cost, Cost, Item.Entrance, true });
+			}
+		}
+
+		for (int32 Edge = EdgeOffsets[Item.Entrance]; Edge < EdgeOffsets[Item.Entrance + 1]; ++Edge)
+		{
+			const int32 Next = EdgeTargets[Edge];
+			const float Cost = Item.Cost + EdgeCosts[Edge];
+
+			FLocalRecord* Record = Records.Find(Next);
+			if (Record && Record->Cost <= Cost)
+			{
+				continue;
+			}
+
+			if (Record)
+			{
+				*Record = { Cost, Item.Entrance };
+			}
+			else
+			{
+				Records.Add(Next, { Cost, Item.Entrance });
+			}
+			Open.HeapPush({ Cost + FVector::Dist(Graph.GetNodeCenter(EntranceNodes[Next]), GoalCenter), Cost, Next, false });
+		}
+	}
+
+	// Same island, but one-way links keep the goal out of reach
+	return false;
+}
+
+void FNavClusterGraph::SearchCluster(const FNavMeshPolyGraph& Graph, int32 Source, bool bReverse, TMap<int32, FLocalRecord>& OutRecords) const
+{
+	OutRecords.Reset();
+
+	const int32 Cluster = NodeClusters[Source];
+
+	TArray<FClusterQueueItem> Open;
+	OutRecords.Add(Source, { 0.0f, INDEX_NONE });
+	Open.HeapPush({ 0.0f, Source });
+
+	while (Open.Num() > 0)
+	{
+		FClusterQueueItem Item;
+		Open.HeapPop(Item, EAllowShrinking::No);
+
+		if (Item.Cost > OutRecords.FindChecked(Item.Node).Cost)
+		{
+			continue;
+		}
+
+		const TArrayView<const int32> Nodes = bReverse ? Graph.GetIncoming(Item.Node) : Graph.GetNeighbors(Item.Node);
+		const TArrayView<const float> Costs = bReverse ? Graph.GetIncomingCosts(Item.Node) : Graph.GetEdgeCosts(Item.Node);
+		for (int32 i = 0; i < Nodes.Num(); ++i)
+		{
+			const int32 Next = Nodes[i];
+			if (NodeClusters[Next] != Cluster)
+			{
+				continue;
+			}
+
+			const float Cost = Item.Cost + Costs[i];
+			FLocalRecord* Record = OutRecords.Find(Next);
+			if (Record && Record->Cost <= Cost)
+			{
+				continue;
+			}
+
+			if (Record)
+			{
+				*Record = { Cost, Item.Node };
+			}
+			else
+			{
+				OutRecords.Add(Next, { Cost, Item.Node });
+			}
+			Open.HeapPush({ Cost, Next });
+		}
+	}
+}
+
+void FNavClusterGraph::AppendForward(const TMap<int32, FLocalRecord>& Records, int32 To, TArray<int32>& OutCorridor)
+{
+	const int32 Begin = OutCorridor.Num();
+	for (int32 Node = To; Records.FindChecked(Node).Link != INDEX_NONE; Node = Records.FindChecked(Node).Link)
+	{
+		OutCorridor.Add(Node);
+	}
+	TArrayView<int32> Appended = MakeArrayView(OutCorridor).Slice(Begin, OutCorridor.Num() - Begin);
+	Algo::Reverse(Appended);
+}
+
+SIZE_T FNavClusterGraph::GetAllocatedSize() const
+{
+	return NodeCells.GetAllocatedSize()
+		+ NodeClusters.GetAllocatedSize()
+		+ NodeEntrances.GetAllocatedSize()
+		+ ClusterNodeOffsets.GetAllocatedSize()
+		+ ClusterNodes.GetAllocatedSize()
+		+ ClusterEntranceOffsets.GetAllocatedSize()
+		+ ClusterEntrances.GetAllocatedSize()
+		+ EntranceNodes.GetAllocatedSize()
+		+ EdgeOffsets.GetAllocatedSize()
+		+ EdgeTargets.GetAllocatedSize()
+		+ EdgeCosts.GetAllocatedSize();
+}
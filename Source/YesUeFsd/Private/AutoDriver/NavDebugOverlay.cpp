@@ -0,0 +1,255 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AutoDriver/NavDebugOverlay.h"
+#include "AutoDriver/AutoDriverStats.h"
+#include "NavMesh/RecastNavMesh.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarNavDebugDraw(
+	TEXT("AutoDriver.Nav.DebugDraw"),
+	1,
+	TEXT("Draw navigation debug paths and navmesh areas requested through UNavigationHelper.\n")
+	TEXT("0: off (debug draw calls return before running any query), 1: on"),
+	ECVF_Default);
+
+namespace
+{
+	constexpr float PathThickness = 3.0f;
+	constexpr float NavMeshThickness = 1.5f;
+	constexpr float MarkerRadius = 25.0f;
+
+	/** Lift navmesh edges off the surface they lie on */
+	constexpr float NavMeshDrawOffset = 5.0f;
+
+	/** Cell size failed queries and areas are keyed by (cm) */
+	constexpr float KeyCellSize = 100.0f;
+
+	FIntVector QuantizeKey(const FVector& Location)
+	{
+		return FIntVector(
+			FMath::FloorToInt32(Location.X / KeyCellSize),
+			FMath::FloorToInt32(Location.Y / KeyCellSize),
+			FMath::FloorToInt32(Location.Z / KeyCellSize));
+	}
+
+	void AddLine(TArray<FBatchedLine>& Lines, const FVector& Start, const FVector& End, const FColor& Color, float Thickness, uint32 BatchId)
+	{
+		// Zero lifetime: the line stays until its batch is cleared
+		Lines.Emplace(Start, End, FLinearColor(Color), 0.0f, Thickness, SDPG_World, BatchId);
+	}
+
+	/** Wire sphere as three great circles */
+	void AddSphere(TArray<FBatchedLine>& Lines, const FVector& Center, float Radius, int32 Segments, const FColor& Color, float Thickness, uint32 BatchId)
+	{
+		const FVector Axes[3][2] = {
+			{ FVector::XAxisVector, FVector::YAxisVector },
+			{ FVector::XAxisVector, FVector::ZAxisVector },
+			{ FVector::YAxisVector, FVector::ZAxisVector },
+		};
+
+		const float Step = UE_TWO_PI / Segments;
+		for (const FVector (&Plane)[2] : Axes)
+		{
+			FVector Previous = Center + Plane[0] * Radius;
+			for (int32 i = 1; i <= Segments; ++i)
+			{
+				float Sin, Cos;
+				FMath::SinCos(&Sin, &Cos, Step * i);
+				const FVector Current = Center + (Plane[0] * Cos + Plane[1] * Sin) * Radius;
+				AddLine(Lines, Previous, Current, Color, Thickness, BatchId);
+				Previous = Current;
+			}
+		}
+	}
+}
+
+bool FNavDebugOverlay::IsEnabled()
+{
+	return CVarNavDebugDraw.GetValueOnGameThread() != 0;
+}
+
+FNavDebugOverlay::FItem& FNavDebugOverlay::Touch(const FItemKey& Key, double ExpireTime, bool& bOutAdded)
+{
+	FItem* Item = Items.Find(Key);
+	bOutAdded = Item == nullptr;
+	if (bOutAdded)
+	{
+		Item = &Items.Add(Key);
+		Item->BatchId = NextBatchId++;
+	}
+
+	Item->ExpireTime = FMath::Max(Item->ExpireTime, ExpireTime);
+	Item->LastDrawnFrame = GFrameCounter;
+	return *Item;
+}
+
+void FNavDebugOverlay::DrawPath(const FVector& From, const FVector& To, const FNavPathSharedPtr& Path, const FColor& Color, double ExpireTime)
+{
+	const bool bValid = Path.IsValid() && Path->IsValid();
+
+	// Paths are keyed by identity, so every agent served the same cached path shares one item
+	FItemKey Key;
+	if (bValid)
+	{
+		Key.Path = Path.Get();
+	}
+	else
+	{
+		Key.A = QuantizeKey(From);
+		Key.B = QuantizeKey(To);
+		Key.Radius = INDEX_NONE;
+	}
+
+	bool bAdded = false;
+	FItem& Item = Touch(Key, ExpireTime, bAdded);
+	if (!bAdded && Item.Color == Color)
+	{
+		return;
+	}
+
+	Item.Color = Color;
+	Item.Lines.Reset();
+	Item.bDirty = true;
+
+	if (bValid)
+	{
+		Item.Path = Path;
+
+		const TArray<FNavPathPoint>& PathPoints = Path->GetPathPoints();
+		for (int32 i = 0; i < PathPoints.Num() - 1; ++i)
+		{
+			AddLine(Item.Lines, PathPoints[i].Location, PathPoints[i + 1].Location, Color, PathThickness, Item.BatchId);
+		}
+
+		AddSphere(Item.Lines, From, MarkerRadius, 12, FColor::Green, 0.0f, Item.BatchId);
+		AddSphere(Item.Lines, To, MarkerRadius, 12, FColor::Red, 0.0f, Item.BatchId);
+	}
+	else
+	{
+		AddLine(Item.Lines, From, To, FColor::Red, PathThickness, Item.BatchId);
+		AddSphere(Item.Lines, From, MarkerRadius, 12, FColor::Yellow, 0.0f, Item.BatchId);
+		AddSphere(Item.Lines, To, MarkerRadius, 12, FColor::Orange, 0.0f, Item.BatchId);
+	}
+}
+
+void FNavDebugOverlay::DrawNavMeshArea(const ANavigationData& NavData, const FVector& Location, float Radius, double ExpireTime)
+{
+	FItemKey Key;
+	Key.A = QuantizeKey(Location);
+	Key.Radius = FMath::CeilToInt32(Radius);
+
+	bool bAdded = false;
+	FItem& Item = Touch(Key, ExpireTime, bAdded);
+	if (!bAdded)
+	{
+		return;
+	}
+
+	Item.bNavMeshArea = true;
+	Item.Color = FColor::Cyan;
+
+	AddSphere(Item.Lines, Location, Radius, 32, FColor::Cyan, 2.0f, Item.BatchId);
+
+#if WITH_RECAST
+	// Polygon outlines, captured once; the item is dropped when the navmesh changes
+	if (const ARecastNavMesh* NavMesh = Cast<const ARecastNavMesh>(&NavData))
+	{
+		TArray<FNavPoly> Polys;
+		NavMesh->GetPolysInBox(FBox::BuildAABB(Location, FVector(Radius)), Polys);
+
+		TArray<FVector> Verts;
+		for (const FNavPoly& Poly : Polys)
+		{
+			if (FVector::DistSquared(Poly.Center, Location) > FMath::Square(Radius) || !NavMesh->GetPolyVerts(Poly.Ref, Verts))
+			{
+				continue;
+			}
+
+			for (int32 i = 0; i < Verts.Num(); ++i)
+			{
+				const FVector Start = Verts[i] + FVector(0.0f, 0.0f, NavMeshDrawOffset);
+				const FVector End = Verts[(i + 1) % Verts.Num()] + FVector(0.0f, 0.0f, NavMeshDrawOffset);
+				AddLine(Item.Lines, Start, End, FColor::Cyan, NavMeshThickness, Item.BatchId);
+			}
+		}
+	}
+#endif
+}
+
+void FNavDebugOverlay::InvalidateNavMeshAreas()
+{
+	for (auto It = Items.CreateIterator(); It; ++It)
+	{
+		if (It->Value.bNavMeshArea)
+		{
+			if (It->Value.bSubmitted)
+			{
+				StaleBatches.Add(It->Value.BatchId);
+			}
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FNavDebugOverlay::Flush(ULineBatchComponent& LineBatcher, double Now)
+{
+	for (const uint32 BatchId : StaleBatches)
+	{
+		LineBatcher.ClearBatch(BatchId);
+	}
+	StaleBatches.Reset();
+
+	for (auto It = Items.CreateIterator(); It; ++It)
+	{
+		FItem& Item = It->Value;
+
+		// Items outlive their duration by a frame, so ones redrawn every frame never blink out
+		// whether the caller runs before or after this flush
+		if (Now > Item.ExpireTime && Item.LastDrawnFrame + 1 < GFrameCounter)
+		{
+			if (Item.bSubmitted)
+			{
+				LineBatcher.ClearBatch(Item.BatchId);
+			}
+			It.RemoveCurrent();
+			continue;
+		}
+
+		if (Item.bDirty)
+		{
+			if (Item.bSubmitted)
+			{
+				LineBatcher.ClearBatch(Item.BatchId);
+			}
+			LineBatcher.DrawLines(Item.Lines);
+			Item.Lines.Empty();
+			Item.bDirty = false;
+			Item.bSubmitted = true;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_AutoDriver_NavDebugItems, Items.Num());
+}
+
+void FNavDebugOverlay::Reset(ULineBatchComponent* LineBatcher)
+{
+	if (LineBatcher)
+	{
+		for (const uint32 BatchId : StaleBatches)
+		{
+			LineBatcher->ClearBatch(BatchId);
+		}
+
+		for (const TPair<FItemKey, FItem>& Pair : Items)
+		{
+			if (Pair.Value.bSubmitted)
+			{
+				LineBatcher->ClearBatch(Pair.Value.BatchId);
+			}
+		}
+	}
+
+	Items.Reset();
+	StaleBatches.Reset();
+	SET_DWORD_STAT(STAT_AutoDriver_NavDebugItems, 0);
+}
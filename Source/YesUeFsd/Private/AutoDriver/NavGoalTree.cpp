@@ -0,0 +1,243 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AutoDriver/NavGoalTree.h"
+#include "AutoDriver/NavMeshPolyGraph.h"
+#include "AutoDriver/AutoDriverStats.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	/** Upper bound on tracked goals without a tree, so one-off destinations cannot grow the map forever */
+	constexpr int32 MaxTrackedGoals = 4096;
+
+	/** Upper bound on trees being built at once; further goals keep counting requests meanwhile */
+	constexpr int32 MaxPendingBuilds = 4;
+
+	/** Nodes settled between clock checks */
+	constexpr int32 NodesPerClockCheck = 64;
+}
+
+// ========================================
+// FNavGoalTree
+// ========================================
+
+FNavGoalTree::FNavGoalTree(const FNavMeshPolyGraph& Graph, int32 InGoalNode)
+	: GoalNode(InGoalNode)
+	, GraphVersion(Graph.GetVersion())
+{
+	const int32 NumNodes = Graph.GetNumNodes();
+	Distances.Init(TNumericLimits<float>::Max(), NumNodes);
+	NextHops.Init(INDEX_NONE, NumNodes);
+
+	if (Distances.IsValidIndex(GoalNode))
+	{
+		Distances[GoalNode] = 0.0f;
+		Open.HeapPush({ 0.0f, GoalNode });
+	}
+}
+
+bool FNavGoalTree::Build(const FNavMeshPolyGraph& Graph, double Deadline)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AutoDriver_NavGoalTreeBuild);
+
+	int32 Settled = 0;
+	while (Open.Num() > 0)
+	{
+		if (++Settled % NodesPerClockCheck == 0 && FPlatformTime::Seconds() >= Deadline)
+		{
+			return false;
+		}
+
+		FQueueItem Item;
+		Open.HeapPop(Item, EAllowShrinking::No);
+
+		// Stale entry left behind by a later relaxation
+		if (Item.Distance > Distances[Item.Node])
+		{
+			continue;
+		}
+
+		// Walk edges backwards: a source of an edge into Node reaches the goal through Node
+		const TArrayView<const int32> Sources = Graph.GetIncoming(Item.Node);
+		const TArrayView<const float> Costs = Graph.GetIncomingCosts(Item.Node);
+		for (int32 i = 0; i < Sources.Num(); ++i)
+		{
+			const int32 Source = Sources[i];
+			const float Distance = Item.Distance + Graph.GetTraversalCost(Source, Item.Node, Costs[i]);
+			if (Distance < Distances[Source])
+			{
+				Distances[Source] = Distance;
+				NextHops[Source] = Item.Node;
+				Open.HeapPush({ Distance, Source });
+			}
+		}
+	}
+
+	Open.Empty();
+	return true;
+}
+
+bool FNavGoalTree::IsValidFor(const FNavMeshPolyGraph& Graph) const
+{
+	return GraphVersion == Graph.GetVersion() && Distances.Num() == Graph.GetNumNodes();
+}
+
+bool FNavGoalTree::GetCorridor(const FNavMeshPolyGraph& Graph, int32 StartNode, TArray<NavNodeRef>& OutCorridor) const
+{
+	OutCorridor.Reset();
+	if (!IsComplete() || !CanReachGoal(StartNode))
+	{
+		return false;
+	}
+
+	// Next hops strictly decrease the distance, so the walk ends at the goal
+	for (int32 Node = StartNode; Node != INDEX_NONE; Node = NextHops[Node])
+	{
+		OutCorridor.Add(Graph.GetNodeRef(Node));
+	}
+
+	return true;
+}
+
+// ========================================
+// FNavGoalTreeCache
+// ========================================
+
+FNavGoalTreeCache::FNavGoalTreeCache(int32 InMaxTrees, int32 InMinRequests)
+	: MaxTrees(FMath::Max(1, InMaxTrees))
+	, MinRequests(FMath::Max(1, InMinRequests))
+{
+}
+
+const FNavGoalTree* FNavGoalTreeCache::Find(const FNavMeshPolyGraph& Graph, int32 GoalNode)
+{
+	if (GraphVersion != Graph.GetVersion())
+	{
+		Reset();
+		GraphVersion = Graph.GetVersion();
+	}
+
+	for (const TUniquePtr<FNavGoalTree>& Tree : Trees)
+	{
+		if (Tree->GetGoalNode() == GoalNode)
+		{
+			++Tree->Uses;
+			return Tree.Get();
+		}
+	}
+
+	for (const TUniquePtr<FNavGoalTree>& Tree : Pending)
+	{
+		if (Tree->GetGoalNode() == GoalNode)
+		{
+			++Tree->Uses;
+			return nullptr;
+		}
+	}
+
+	int32& Count = RequestCounts.FindOrAdd(GoalNode);
+	++Count;
+	if (Count < MinRequests || Pending.Num() >= MaxPendingBuilds || !CanAdmit(Count))
+	{
+		if (RequestCounts.Num() > MaxTrackedGoals)
+		{
+			RequestCounts.Reset();
+		}
+		return nullptr;
+	}
+
+	// The requests so far count as uses, so a new tree does not start out as the least used
+	TUniquePtr<FNavGoalTree> Tree = MakeUnique<FNavGoalTree>(Graph, GoalNode);
+	Tree->Uses = Count;
+	RequestCounts.Remove(GoalNode);
+	Pending.Add(MoveTemp(Tree));
+	return nullptr;
+}
+
+void FNavGoalTreeCache::BuildPending(const FNavMeshPolyGraph& Graph, double Deadline)
+{
+	if (GraphVersion != Graph.GetVersion())
+	{
+		Reset();
+		GraphVersion = Graph.GetVersion();
+		return;
+	}
+
+	// The oldest build always gets a slice, so it progresses even when the budget is spent
+	while (Pending.Num() > 0)
+	{
+		if (!Pending[0]->Build(Graph, Deadline))
+		{
+			return;
+		}
+
+		TUniquePtr<FNavGoalTree> Tree = MoveTemp(Pending[0]);
+		Pending.RemoveAt(0, 1, EAllowShrinking::No);
+		Admit(MoveTemp(Tree));
+
+		if (FPlatformTime::Seconds() >= Deadline)
+		{
+			return;
+		}
+	}
+}
+
+bool FNavGoalTreeCache::CanAdmit(int32 RequestCount) const
+{
+	if (Trees.Num() + Pending.Num() < MaxTrees)
+	{
+		return true;
+	}
+
+	int32 MinUses = MAX_int32;
+	for (const TUniquePtr<FNavGoalTree>& Tree : Trees)
+	{
+		MinUses = FMath::Min(MinUses, Tree->Uses);
+	}
+	return RequestCount > MinUses;
+}
+
+void FNavGoalTreeCache::Admit(TUniquePtr<FNavGoalTree> Tree)
+{
+	if (Trees.Num() >= MaxTrees)
+	{
+		int32 Victim = 0;
+		for (int32 Index = 1; Index < Trees.Num(); ++Index)
+		{
+			if (Trees[Index]->Uses < Trees[Victim]->Uses)
+			{
+				Victim = Index;
+			}
+		}
+		Trees.RemoveAtSwap(Victim, 1, EAllowShrinking::No);
+
+		// Age the survivors, so goals that were popular long ago eventually make room
+		for (const TUniquePtr<FNavGoalTree>& Survivor : Trees)
+		{
+			Survivor->Uses /= 2;
+		}
+	}
+
+	Trees.Add(MoveTemp(Tree));
+}
+
+void FNavGoalTreeCache::Reset()
+{
+	Trees.Reset();
+	Pending.Reset();
+	RequestCounts.Reset();
+}
+
+SIZE_T FNavGoalTreeCache::GetAllocatedSize() const
+{
+	SIZE_T Size = Trees.GetAllocatedSize() + Pending.GetAllocatedSize() + RequestCounts.GetAllocatedSize();
+	for (const TUniquePtr<FNavGoalTree>& Tree : Trees)
+	{
+		Size += sizeof(FNavGoalTree) + Tree->GetAllocatedSize();
+	}
+	for (const TUniquePtr<FNavGoalTree>& Tree : Pending)
+	{
+		Size += sizeof(FNavGoalTree) + Tree->GetAllocatedSize();
+	}
+	return Size;
+}
@@ -0,0 +1,413 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AutoDriver/NavMeshPolyGraph.h"
+#include "NavigationData.h"
+#include "NavMesh/RecastNavMesh.h"
+#include "Misc/Crc.h"
+
+bool FNavMeshPolyGraph::Build(const ANavigationData& NavData)
+{
+#if WITH_RECAST
+	const ARecastNavMesh* NavMesh = Cast<const ARecastNavMesh>(&NavData);
+	if (!NavMesh)
+	{
+		return false;
+	}
+
+	// GetNavMeshTilesCount is the number of non-empty tiles, not the range of tile indices: with
+	// removed, streamed or dynamic tiles the tile pool is sparse. Ask for the indices of every
+	// tile instead.
+	TArray<int32> TileIndices;
+	const FBox NavMeshBounds = NavMesh->GetNavMeshBounds();
+	if (NavMeshBounds.IsValid)
+	{
+		NavMesh->GetNavMeshTilesIn({ NavMeshBounds.ExpandBy(1.0) }, TileIndices);
+	}
+
+	Tiles.Reset();
+	for (int32 TileIndex : TileIndices)
+	{
+		ExtractTile(*NavMesh, TileIndex);
+	}
+
+	PendingDirtyBounds.Reset();
+	UpdateAreaCosts(*NavMesh);
+	Flatten();
+	bBuilt = true;
+	bStale = false;
+
+	UE_LOG(LogTemp, Log, TEXT("NavMeshPolyGraph: Built %d nodes, %d edges, %d islands for %s"),
+		NodeRefs.Num(), EdgeTargets.Num(), NumComponents, *NavData.GetName());
+	return true;
+#else
+	return false;
+#endif
+}
+
+void FNavMeshPolyGraph::MarkDirty(const FBox& DirtyBounds)
+{
+	if (bBuilt)
+	{
+		PendingDirtyBounds.Add(DirtyBounds);
+		bStale = true;
+	}
+}
+
+void FNavMeshPolyGraph::OnNavMeshRebuilt(const ANavigationData& NavData)
+{
+#if WITH_RECAST
+	const ARecastNavMesh* NavMesh = Cast<const ARecastNavMesh>(&NavData);
+	if (!bBuilt || !NavMesh)
+	{
+		return;
+	}
+
+	// A rebuild without recorded regions (e.g. a full regeneration) invalidates everything
+	if (PendingDirtyBounds.Num() == 0)
+	{
+		Build(NavData);
+		return;
+	}
+
+	TArray<int32> DirtyTiles;
+	NavMesh->GetNavMeshTilesIn(PendingDirtyBounds, DirtyTiles);
+	PendingDirtyBounds.Reset();
+
+	// Detour reconnects the border links of tiles next to a rebuilt tile, and refs into the
+	// rebuilt tile change salt, so the tiles linked to it (in either direction, before or
+	// after the rebuild) are re-extracted as well
+	TSet<int32> TilesToExtract(DirtyTiles);
+	for (const TPair<int32, FTileData>& Pair : Tiles)
+	{
+		const bool bIsDirty = DirtyTiles.Contains(Pair.Key);
+		for (int32 LinkedTile : Pair.Value.LinkedTiles)
+		{
+			if (bIsDirty)
+			{
+				TilesToExtract.Add(LinkedTile);
+			}
+			else if (DirtyTiles.Contains(LinkedTile))
+			{
+				TilesToExtract.Add(Pair.Key);
+			}
+		}
+	}
+
+	for (int32 TileIndex : DirtyTiles)
+	{
+		ExtractTile(*NavMesh, TileIndex);
+		if (const FTileData* Tile = Tiles.Find(TileIndex))
+		{
+			TilesToExtract.Append(Tile->LinkedTiles);
+		}
+	}
+
+	for (int32 TileIndex : TilesToExtract)
+	{
+		if (!DirtyTiles.Contains(TileIndex))
+		{
+			ExtractTile(*NavMesh, TileIndex);
+		}
+	}
+
+	UpdateAreaCosts(*NavMesh);
+	Flatten();
+	bStale = false;
+
+	UE_LOG(LogTemp, Verbose, TEXT("NavMeshPolyGraph: Refreshed %d tiles (%d dirty), %d nodes, %d islands"),
+		TilesToExtract.Num(), DirtyTiles.Num(), NodeRefs.Num(), NumComponents);
+#endif
+}
+
+bool FNavMeshPolyGraph::AreDisconnected(const ANavigationData& NavData, const FVector& From, const FVector& To) const
+{
+	if (!IsReady())
+	{
+		return false;
+	}
+
+	FNavLocation FromLocation;
+	FNavLocation ToLocation;
+	int32 FromNode;
+	int32 ToNode;
+	if (!ProjectToNode(NavData, From, FromLocation, FromNode) || !ProjectToNode(NavData, To, ToLocation, ToNode))
+	{
+		return false;
+	}
+
+	return Components[FromNode] != Components[ToNode];
+}
+
+bool FNavMeshPolyGraph::ProjectToNode(const ANavigationData& NavData, const FVector& Location, FNavLocation& OutLocation, int32& OutNode) const
+{
+	OutNode = INDEX_NONE;
+	if (!NavData.ProjectPoint(Location, OutLocation, NavData.GetConfig().DefaultQueryExtent))
+	{
+		return false;
+	}
+
+	OutNode = FindNode(OutLocation.NodeRef);
+	return OutNode != INDEX_NONE;
+}
+
+SIZE_T FNavMeshPolyGraph::GetAllocatedSize() const
+{
+	SIZE_T Size = Tiles.GetAllocatedSize()
+		+ NodeRefs.GetAllocatedSize()
+		+ NodeCenters.GetAllocatedSize()
+		+ Components.GetAllocatedSize()
+		+ NodeLookup.GetAllocatedSize()
+		+ NodeAreas.GetAllocatedSize()
+		+ NodeAreaCosts.GetAllocatedSize()
+		+ NodeEnteringCosts.GetAllocatedSize()
+		+ EdgeOffsets.GetAllocatedSize()
+		+ EdgeTargets.GetAllocatedSize()
+		+ EdgeCosts.GetAllocatedSize()
+		+ ReverseOffsets.GetAllocatedSize()
+		+ ReverseSources.GetAllocatedSize()
+		+ ReverseCosts.GetAllocatedSize()
+		+ PendingDirtyBounds.GetAllocatedSize();
+
+	for (const TPair<int32, FTileData>& Pair : Tiles)
+	{
+		Size += Pair.Value.Polys.GetAllocatedSize()
+			+ Pair.Value.Centers.GetAllocatedSize()
+			+ Pair.Value.Areas.GetAllocatedSize()
+			+ Pair.Value.LinkOffsets.GetAllocatedSize()
+			+ Pair.Value.Links.GetAllocatedSize()
+			+ Pair.Value.LinkedTiles.GetAllocatedSize();
+	}
+
+	return Size;
+}
+
+void FNavMeshPolyGraph::ExtractTile(const ARecastNavMesh& NavMesh, int32 TileIndex)
+{
+#if WITH_RECAST
+	TArray<FNavPoly> Polys;
+	if (!NavMesh.GetPolysInTile(TileIndex, Polys) || Polys.Num() == 0)
+	{
+		Tiles.Remove(TileIndex);
+		return;
+	}
+
+	FTileData& Tile = Tiles.FindOrAdd(TileIndex);
+	Tile.Polys.Reset(Polys.Num());
+	Tile.Centers.Reset(Polys.Num());
+	Tile.Areas.Reset(Polys.Num());
+	Tile.LinkOffsets.Reset(Polys.Num() + 1);
+	Tile.Links.Reset();
+	Tile.LinkedTiles.Reset();
+
+	TSet<NavNodeRef> Known;
+	for (const FNavPoly& Poly : Polys)
+	{
+		Tile.Polys.Add(Poly.Ref);
+		Tile.Centers.Add(Poly.Center);
+		Tile.Areas.Add(static_cast<uint8>(NavMesh.GetPolyAreaID(Poly.Ref)));
+		Known.Add(Poly.Ref);
+	}
+
+	// Off-mesh link polygons are not listed with the ground polygons but are linked from
+	// them; append the ones living in this tile so jump links keep islands connected.
+	// The loop walks the appended polygons too, recording their own links.
+	TArray<NavNodeRef> Neighbors;
+	for (int32 PolyIndex = 0; PolyIndex < Tile.Polys.Num(); ++PolyIndex)
+	{
+		Tile.LinkOffsets.Add(Tile.Links.Num());
+
+		Neighbors.Reset();
+		NavMesh.GetPolyNeighbors(Tile.Polys[PolyIndex], Neighbors);
+
+		for (NavNodeRef Neighbor : Neighbors)
+		{
+			Tile.Links.Add(Neighbor);
+
+			uint32 NeighborPolyIndex, NeighborTileIndex;
+			if (!NavMesh.GetPolyTileIndex(Neighbor, NeighborPolyIndex, NeighborTileIndex))
+			{
+				continue;
+			}
+
+			if (static_cast<int32>(NeighborTileIndex) != TileIndex)
+			{
+				Tile.LinkedTiles.Add(static_cast<int32>(NeighborTileIndex));
+				continue;
+			}
+
+			FVector Center;
+			if (!Known.Contains(Neighbor) && NavMesh.GetPolyCenter(Neighbor, Center))
+			{
+				Known.Add(Neighbor);
+				Tile.Polys.Add(Neighbor);
+				Tile.Centers.Add(Center);
+				Tile.Areas.Add(static_cast<uint8>(NavMesh.GetPolyAreaID(Neighbor)));
+			}
+		}
+	}
+	Tile.LinkOffsets.Add(Tile.Links.Num());
+#endif
+}
+
+void FNavMeshPolyGraph::UpdateAreaCosts(const ARecastNavMesh& NavMesh)
+{
+#if WITH_RECAST
+	AreaCostTable.Init(1.0f, RECAST_MAX_AREAS);
+	EnteringCostTable.Init(0.0f, RECAST_MAX_AREAS);
+
+	// The filter every default-filter query (and therefore the shared cache) is answered with
+	if (FSharedConstNavQueryFilter Filter = NavMesh.GetDefaultQueryFilter())
+	{
+		Filter->GetAllAreaCosts(AreaCostTable.GetData(), EnteringCostTable.GetData(), RECAST_MAX_AREAS);
+	}
+#endif
+}
+
+void FNavMeshPolyGraph::Flatten()
+{
+	NodeRefs.Reset();
+	NodeCenters.Reset();
+	NodeLookup.Reset();
+	NodeAreas.Reset();
+	NodeAreaCosts.Reset();
+	NodeEnteringCosts.Reset();
+	MinAreaCost = TNumericLimits<float>::Max();
+
+	// Stable node order (by tile index) keeps results deterministic across refreshes
+	Tiles.KeySort(TLess<int32>());
+
+	for (const TPair<int32, FTileData>& Pair : Tiles)
+	{
+		for (int32 i = 0; i < Pair.Value.Polys.Num(); ++i)
+		{
+			NodeLookup.Add(Pair.Value.Polys[i], NodeRefs.Num());
+			NodeRefs.Add(Pair.Value.Polys[i]);
+			NodeCenters.Add(Pair.Value.Centers[i]);
+
+			const uint8 Area = Pair.Value.Areas[i];
+			const float AreaCost = AreaCostTable.IsValidIndex(Area) ? AreaCostTable[Area] : 1.0f;
+			NodeAreas.Add(Area);
+			NodeAreaCosts.Add(AreaCost);
+			NodeEnteringCosts.Add(EnteringCostTable.IsValidIndex(Area) ? EnteringCostTable[Area] : 0.0f);
+			MinAreaCost = FMath::Min(MinAreaCost, AreaCost);
+		}
+	}
+
+	if (NodeRefs.Num() == 0)
+	{
+		MinAreaCost = 1.0f;
+	}
+
+	EdgeOffsets.Reset(NodeRefs.Num() + 1);
+	EdgeTargets.Reset();
+	EdgeCosts.Reset();
+
+	for (const TPair<int32, FTileData>& Pair : Tiles)
+	{
+		const FTileData& Tile = Pair.Value;
+		for (int32 i = 0; i < Tile.Polys.Num(); ++i)
+		{
+			const int32 Node = EdgeOffsets.Num();
+			EdgeOffsets.Add(EdgeTargets.Num());
+
+			for (int32 LinkIndex = Tile.LinkOffsets[i]; LinkIndex < Tile.LinkOffsets[i + 1]; ++LinkIndex)
+			{
+				const int32 Target = FindNode(Tile.Links[LinkIndex]);
+				if (Target != INDEX_NONE && Target != Node)
+				{
+					EdgeTargets.Add(Target);
+					EdgeCosts.Add(FVector::Dist(NodeCenters[Node], NodeCenters[Target]));
+				}
+			}
+		}
+	}
+	EdgeOffsets.Add(EdgeTargets.Num());
+
+	BuildReverseEdges();
+	LabelComponents();
+	++Version;
+
+	DataHash = FCrc::MemCrc32(NodeRefs.GetData(), NodeRefs.Num() * NodeRefs.GetTypeSize());
+	DataHash = FCrc::MemCrc32(NodeCenters.GetData(), NodeCenters.Num() * NodeCenters.GetTypeSize(), DataHash);
+	DataHash = FCrc::MemCrc32(EdgeOffsets.GetData(), EdgeOffsets.Num() * EdgeOffsets.GetTypeSize(), DataHash);
+	DataHash = FCrc::MemCrc32(EdgeTargets.GetData(), EdgeTargets.Num() * EdgeTargets.GetTypeSize(), DataHash);
+	DataHash = FCrc::MemCrc32(NodeAreaCosts.GetData(), NodeAreaCosts.Num() * NodeAreaCosts.GetTypeSize(), DataHash);
+}
+
+void FNavMeshPolyGraph::BuildReverseEdges()
+{
+	const int32 NumNodes = NodeRefs.Num();
+
+	ReverseOffsets.Reset(NumNodes + 1);
+	ReverseOffsets.SetNumZeroed(NumNodes + 1);
+	for (int32 Target : EdgeTargets)
+	{
+		++ReverseOffsets[Target + 1];
+	}
+	for (int32 Node = 0; Node < NumNodes; ++Node)
+	{
+		ReverseOffsets[Node + 1] += ReverseOffsets[Node];
+	}
+
+	ReverseSources.SetNumUninitialized(EdgeTargets.Num());
+	ReverseCosts.SetNumUninitialized(EdgeTargets.Num());
+
+	TArray<int32> Cursor(ReverseOffsets.GetData(), NumNodes);
+	for (int32 Node = 0; Node < NumNodes; ++Node)
+	{
+		for (int32 Edge = EdgeOffsets[Node]; Edge < EdgeOffsets[Node + 1]; ++Edge)
+		{
+			const int32 Slot = Cursor[EdgeTargets[Edge]]++;
+			ReverseSources[Slot] = Node;
+			ReverseCosts[Slot] = EdgeCosts[Edge];
+		}
+	}
+}
+
+void FNavMeshPolyGraph::LabelComponents()
+{
+	const int32 NumNodes = NodeRefs.Num();
+
+	Components.Init(INDEX_NONE, NumNodes);
+	NumComponents = 0;
+
+	TArray<int32> Queue;
+	Queue.Reserve(NumNodes);
+
+	for (int32 Seed = 0; Seed < NumNodes; ++Seed)
+	{
+		if (Components[Seed] != INDEX_NONE)
+		{
+			continue;
+		}
+
+		const int32 Label = NumComponents++;
+		Components[Seed] = Label;
+		Queue.Reset();
+		Queue.Add(Seed);
+
+		for (int32 Head = 0; Head < Queue.Num(); ++Head)
+		{
+			const int32 Node = Queue[Head];
+
+			auto Visit = [this, Label, &Queue](int32 Next)
+			{
+				if (Components[Next] == INDEX_NONE)
+				{
+					Components[Next] = Label;
+					Queue.Add(Next);
+				}
+			};
+
+			// Undirected view: one-way links must still merge their endpoints
+			for (int32 Next : GetNeighbors(Node))
+			{
+				Visit(Next);
+			}
+			for (int32 Next : GetIncoming(Node))
+			{
+				Visit(Next);
+			}
+		}
+	}
+}
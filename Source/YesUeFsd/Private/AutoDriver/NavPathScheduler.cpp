@@ -0,0 +1,327 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AutoDriver/NavPathScheduler.h"
+#include "AutoDriver/NavMeshPolyGraph.h"
+#include "AutoDriver/NavigationCache.h"
+#include "AutoDriver/AutoDriverStats.h"
+#include "NavigationData.h"
+#include "NavMesh/NavMeshPath.h"
+#include "NavMesh/RecastNavMesh.h"
+#include "HAL/PlatformTime.h"
+#include "Algo/Reverse.h"
+
+namespace
+{
+	/** Nodes expanded between clock reads */
+	constexpr int32 ExpansionsPerClockCheck = 64;
+
+	/** Frames a finished result waits to be collected before it is dropped */
+	constexpr uint64 MaxUncollectedFrames = 600;
+}
+
+int32 FNavPathScheduler::Submit(const ANavigationData& NavData, FNavigationQueryCache* Cache, const FVector& From, const FVector& To, int32 Priority)
+{
+	const int32 RequestId = NextRequestId++;
+
+	FRequest& Request = Requests.Add(RequestId);
+	Request.Priority = Priority;
+	Request.Sequence = NextSequence++;
+	Request.NavData = &NavData;
+	Request.Cache = Cache;
+	Request.From = From;
+	Request.To = To;
+
+	INC_DWORD_STAT(STAT_AutoDriver_NavTimeSlicedRequests);
+	return RequestId;
+}
+
+int32 FNavPathScheduler::AddFinished(FNavPathSharedPtr Path)
+{
+	const int32 RequestId = NextRequestId++;
+
+	FRequest& Request = Requests.Add(RequestId);
+	Request.Sequence = NextSequence++;
+	Request.Status = Path.IsValid() && Path->IsValid() ? ENavPathRequestStatus::Complete : ENavPathRequestStatus::Failed;
+	Request.Path = MoveTemp(Path);
+	Request.FinishedFrame = GFrameCounter;
+
+	return RequestId;
+}
+
+ENavPathRequestStatus FNavPathScheduler::Poll(int32 RequestId, FNavPathSharedPtr& OutPath)
+{
+	OutPath.Reset();
+
+	FRequest* Request = Requests.Find(RequestId);
+	if (!Request)
+	{
+		return ENavPathRequestStatus::Invalid;
+	}
+
+	const ENavPathRequestStatus Status = Request->Status;
+	OutPath = Request->Path;
+
+	if (Status == ENavPathRequestStatus::Complete || Status == ENavPathRequestStatus::Failed)
+	{
+		Requests.Remove(RequestId);
+	}
+
+	return Status;
+}
+
+void FNavPathScheduler::Cancel(int32 RequestId)
+{
+	Requests.Remove(RequestId);
+}
+
+void FNavPathScheduler::Tick(double BudgetSeconds, TFunctionRef<const FNavMeshPolyGraph*(const ANavigationData*)> GetGraph)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AutoDriver_NavTimeSlicedSearch);
+
+	// Serve the highest priority first, oldest first within a priority
+	TArray<TPair<int32, FRequest*>, TInlineAllocator<16>> Pending;
+	for (auto It = Requests.CreateIterator(); It; ++It)
+	{
+		FRequest& Request = It.Value();
+		if (Request.Status == ENavPathRequestStatus::Pending || Request.Status == ENavPathRequestStatus::Partial)
+		{
+			Pending.Emplace(It.Key(), &Request);
+		}
+		else if (GFrameCounter - Request.FinishedFrame > MaxUncollectedFrames)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	if (Pending.Num() == 0)
+	{
+		return;
+	}
+
+	Pending.Sort([](const TPair<int32, FRequest*>& A, const TPair<int32, FRequest*>& B)
+	{
+		return A.Value->Priority != B.Value->Priority
+			? A.Value->Priority > B.Value->Priority
+			: A.Value->Sequence < B.Value->Sequence;
+	});
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double Deadline = StartTime + FMath::Max(BudgetSeconds, 0.0);
+
+	for (int32 Index = 0; Index < Pending.Num(); ++Index)
+	{
+		// Past the budget only the top request gets its one slice, so it always makes progress
+		if (Index > 0 && FPlatformTime::Seconds() >= Deadline)
+		{
+			break;
+		}
+
+		FRequest& Request = *Pending[Index].Value;
+
+		const ANavigationData* NavData = Request.NavData.Get();
+		if (!NavData)
+		{
+			Finish(Request, nullptr);
+			continue;
+		}
+
+		// Navmesh rebuilding: wait, and restart once the graph is back
+		const FNavMeshPolyGraph* Graph = GetGraph(NavData);
+		if (!Graph)
+		{
+			continue;
+		}
+
+		if (Request.GraphVersion != Graph->GetVersion())
+		{
+			BeginSearch(Request, *NavData, *Graph);
+			if (Request.Status != ENavPathRequestStatus::Pending && Request.Status != ENavPathRequestStatus::Partial)
+			{
+				continue;
+			}
+		}
+
+		if (StepSearch(Request, *NavData, *Graph, Deadline))
+		{
+			continue;
+		}
+
+		// Still searching: let movement start towards the best polygon found so far, and only
+		// republish once that got much closer to the goal, since each partial path is string-pulled
+		if (Request.BestNode != INDEX_NONE && Request.BestDistance < Request.PartialDistance * 0.5f)
+		{
+			if (FNavPathSharedPtr Partial = BuildPath(Request, *NavData, *Graph, Request.BestNode, Graph->GetNodeCenter(Request.BestNode)))
+			{
+				Partial->SetIsPartial(true);
+				Request.Path = MoveTemp(Partial);
+				Request.Status = ENavPathRequestStatus::Partial;
+				Request.PartialDistance = Request.BestDistance;
+			}
+		}
+	}
+}
+
+int32 FNavPathScheduler::GetNumPending() const
+{
+	int32 NumPending = 0;
+	for (const TPair<int32, FRequest>& Pair : Requests)
+	{
+		if (Pair.Value.Status == ENavPathRequestStatus::Pending || Pair.Value.Status == ENavPathRequestStatus::Partial)
+		{
+			++NumPending;
+		}
+	}
+	return NumPending;
+}
+
+void FNavPathScheduler::Reset()
+{
+	Requests.Reset();
+}
+
+void FNavPathScheduler::BeginSearch(FRequest& Request, const ANavigationData& NavData, const FNavMeshPolyGraph& Graph)
+{
+	Request.GraphVersion = Graph.GetVersion();
+	Request.Open.Reset();
+	Request.Visited.Reset();
+	Request.BestNode = INDEX_NONE;
+	Request.BestDistance = TNumericLimits<float>::Max();
+	Request.PartialDistance = TNumericLimits<float>::Max();
+
+	FNavLocation FromLocation;
+	FNavLocation ToLocation;
+	int32 StartNode;
+	if (!Graph.ProjectToNode(NavData, Request.From, FromLocation, StartNode)
+		|| !Graph.ProjectToNode(NavData, Request.To, ToLocation, Request.GoalNode))
+	{
+		Finish(Request, nullptr);
+		return;
+	}
+
+	// Different islands: a search would only exhaust the start island
+	if (Graph.GetComponent(StartNode) != Graph.GetComponent(Request.GoalNode))
+	{
+		INC_DWORD_STAT(STAT_AutoDriver_NavIslandRejections);
+		Finish(Request, nullptr);
+		return;
+	}
+
+	Request.FromOnNavMesh = FromLocation.Location;
+	Request.ToOnNavMesh = ToLocation.Location;
+
+	// Edges are weighted by area cost; scaling the straight-line estimate by the cheapest area keeps it admissible
+	Request.HeuristicScale = Graph.GetMinAreaCost();
+
+	const float Cost = FVector::Dist(Request.FromOnNavMesh, Graph.GetNodeCenter(StartNode)) * Graph.GetNodeAreaCost(StartNode);
+	Request.Visited.Add(StartNode, { Cost, INDEX_NONE });
+	Request.Open.HeapPush({ Cost + FVector::Dist(Graph.GetNodeCenter(StartNode), Request.ToOnNavMesh) * Request.HeuristicScale, Cost, StartNode });
+}
+
+bool FNavPathScheduler::StepSearch(FRequest& Request, const ANavigationData& NavData, const FNavMeshPolyGraph& Graph, double Deadline)
+{
+	int32 Expansions = 0;
+	while (Request.Open.Num() > 0)
+	{
+		if (++Expansions % ExpansionsPerClockCheck == 0 && FPlatformTime::Seconds() >= Deadline)
+		{
+			return false;
+		}
+
+		FQueueItem Item;
+		Request.Open.HeapPop(Item, EAllowShrinking::No);
+
+		// Stale entry left behind by a later relaxation
+		if (Item.Cost > Request.Visited.FindChecked(Item.Node).Cost)
+		{
+			continue;
+		}
+
+		if (Item.Node == Request.GoalNode)
+		{
+			Finish(Request, BuildPath(Request, NavData, Graph, Item.Node, Request.ToOnNavMesh));
+			return true;
+		}
+
+		const float Distance = FVector::Dist(Graph.GetNodeCenter(Item.Node), Request.ToOnNavMesh);
+		if (Distance < Request.BestDistance)
+		{
+			Request.BestDistance = Distance;
+			Request.BestNode = Item.Node;
+		}
+
+		const TArrayView<const int32> Neighbors = Graph.GetNeighbors(Item.Node);
+		const TArrayView<const float> EdgeCosts = Graph.GetEdgeCosts(Item.Node);
+		for (int32 i = 0; i < Neighbors.Num(); ++i)
+		{
+			const int32 Next = Neighbors[i];
+			const float Cost = Item.Cost + Graph.GetTraversalCost(Item.Node, Next, EdgeCosts[i]);
+
+			FNodeRecord* Record = Request.Visited.Find(Next);
+			if (Record && Record->Cost <= Cost)
+			{
+				continue;
+			}
+
+			if (Record)
+			{
+				*Record = { Cost, Item.Node };
+			}
+			else
+			{
+				Request.Visited.Add(Next, { Cost, Item.Node });
+			}
+			Request.Open.HeapPush({ Cost + FVector::Dist(Graph.GetNodeCenter(Next), Request.ToOnNavMesh) * Request.HeuristicScale, Cost, Next });
+		}
+	}
+
+	// Islands are computed over undirected edges, so one-way links can still leave the goal out of reach
+	Finish(Request, nullptr);
+	return true;
+}
+
+FNavPathSharedPtr FNavPathScheduler::BuildPath(const FRequest& Request, const ANavigationData& NavData, const FNavMeshPolyGraph& Graph, int32 Node, const FVector& End) const
+{
+#if WITH_RECAST
+	const ARecastNavMesh* NavMesh = Cast<const ARecastNavMesh>(&NavData);
+	if (!NavMesh)
+	{
+		return nullptr;
+	}
+
+	TSharedRef<FNavMeshPath, ESPMode::ThreadSafe> Path = MakeShared<FNavMeshPath, ESPMode::ThreadSafe>();
+	for (int32 Current = Node; Current != INDEX_NONE; Current = Request.Visited.FindChecked(Current).Parent)
+	{
+		Path->PathCorridor.Add(Graph.GetNodeRef(Current));
+	}
+	Algo::Reverse(Path->PathCorridor);
+
+	if (!NavMesh->FindStraightPath(Request.FromOnNavMesh, End, Path->PathCorridor, Path->GetPathPoints()))
+	{
+		return nullptr;
+	}
+
+	Path->SetNavigationDataUsed(NavMesh);
+	Path->MarkReady();
+	return Path;
+#else
+	return nullptr;
+#endif
+}
+
+void FNavPathScheduler::Finish(FRequest& Request, FNavPathSharedPtr Path)
+{
+	const bool bReachable = Path.IsValid() && Path->IsValid();
+	const float PathLength = bReachable ? Path->GetLength() : 0.0f;
+
+	if (Request.Cache)
+	{
+		Request.Cache->CachePath(Request.From, Request.To, bReachable ? Path : FNavPathSharedPtr(), PathLength);
+	}
+
+	Request.Status = bReachable ? ENavPathRequestStatus::Complete : ENavPathRequestStatus::Failed;
+	Request.Path = bReachable ? MoveTemp(Path) : FNavPathSharedPtr();
+	Request.FinishedFrame = GFrameCounter;
+
+	Request.Open.Empty();
+	Request.Visited.Empty();
+}
@@ -0,0 +1,159 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AutoDriver/NavPointPool.h"
+#include "AutoDriver/NavMeshPolyGraph.h"
+#include "AutoDriver/AutoDriverStats.h"
+#include "NavigationData.h"
+
+FNavPointPool::FNavPointPool(const FVector& InCenter, float InRadius, bool bInStratified, int32 InCapacity)
+	: Center(InCenter)
+	, Radius(InRadius)
+	, bStratified(bInStratified)
+	, Capacity(bInStratified ? StrataPerSide * StrataPerSide : FMath::Max(1, InCapacity))
+{
+	Points.Reserve(Capacity);
+	Islands.Reserve(Capacity);
+}
+
+bool FNavPointPool::Draw(const FVector& Origin, float InRadius, const FNavMeshPolyGraph* Graph, int32 Island, FVector& OutLocation)
+{
+	SyncGraph(Graph);
+
+	const float RadiusSquared = InRadius * InRadius;
+
+	// Origins within the pool's region overlap most of its disc, so a few tries nearly always succeed
+	const int32 MaxTries = 4;
+	for (int32 Try = 0; Try < MaxTries && Points.Num() > 0; ++Try)
+	{
+		const int32 Index = FMath::RandRange(0, Points.Num() - 1);
+		if (FVector::DistSquared2D(Points[Index], Origin) > RadiusSquared
+			|| (Island != INDEX_NONE && Islands[Index] != INDEX_NONE && Islands[Index] != Island))
+		{
+			continue;
+		}
+
+		OutLocation = Points[Index];
+		Points.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		Islands.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		return true;
+	}
+
+	return false;
+}
+
+bool FNavPointPool::NeedsRefill() const
+{
+	if (bStratified)
+	{
+		// Finish the current cycle, and only start the next once it has been drawn completely
+		return NextStratum < StrataPerSide * StrataPerSide || Points.Num() == 0;
+	}
+
+	return Points.Num() < Capacity;
+}
+
+int32 FNavPointPool::Refill(const ANavigationData& NavData, const FNavMeshPolyGraph* Graph, int32 MaxSamples)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AutoDriver_NavPointPoolRefill);
+
+	SyncGraph(Graph);
+
+	if (Graph && !bCenterResolved)
+	{
+		FNavLocation CenterLocation;
+		int32 CenterNode;
+		CenterIsland = Graph->ProjectToNode(NavData, Center, CenterLocation, CenterNode) ? Graph->GetComponent(CenterNode) : INDEX_NONE;
+		bCenterResolved = true;
+	}
+
+	const int32 NumStrata = StrataPerSide * StrataPerSide;
+	if (bStratified && NextStratum >= NumStrata && Points.Num() == 0)
+	{
+		NextStratum = 0;
+	}
+
+	// Stratified sampling needs island labels to reject strata that cannot be reached
+	const bool bSampleStrata = bStratified && Graph && CenterIsland != INDEX_NONE;
+
+	int32 NumSamples = 0;
+	while (NumSamples < MaxSamples && NeedsRefill() && (!bStratified || NextStratum < NumStrata))
+	{
+		++NumSamples;
+
+		FNavLocation Location;
+		if (bSampleStrata)
+		{
+			const int32 Stratum = NextStratum++;
+			const float StratumSize = 2.0f * Radius / StrataPerSide;
+			const FVector Corner = Center - FVector(Radius, Radius, 0.0f)
+				+ FVector((Stratum % StrataPerSide) * StratumSize, (Stratum / StrataPerSide) * StratumSize, 0.0f);
+			const FVector Candidate = Corner + FVector(FMath::FRand() * StratumSize, FMath::FRand() * StratumSize, 0.0f);
+
+			if (FVector::DistSquared2D(Candidate, Center) > Radius * Radius)
+			{
+				continue;
+			}
+
+			const FVector Extent(StratumSize * 0.5f, StratumSize * 0.5f, NavData.GetConfig().DefaultQueryExtent.Z);
+			if (!NavData.ProjectPoint(Candidate, Location, Extent))
+			{
+				continue;
+			}
+		}
+		else
+		{
+			if (bStratified)
+			{
+				++NextStratum;
+			}
+
+			if (!NavData.GetRandomReachablePointInRadius(Center, Radius, Location))
+			{
+				continue;
+			}
+		}
+
+		const int32 Node = Graph ? Graph->FindNode(Location.NodeRef) : INDEX_NONE;
+		const int32 Island = Node != INDEX_NONE ? Graph->GetComponent(Node) : INDEX_NONE;
+		if (bSampleStrata && Island != CenterIsland)
+		{
+			continue;
+		}
+
+		Points.Add(Location.Location);
+		Islands.Add(Island);
+	}
+
+	return NumSamples;
+}
+
+void FNavPointPool::RemoveInBounds(const FBox& Bounds)
+{
+	for (int32 Index = Points.Num() - 1; Index >= 0; --Index)
+	{
+		if (Bounds.IsInside(Points[Index]))
+		{
+			Points.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			Islands.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		}
+	}
+}
+
+void FNavPointPool::SyncGraph(const FNavMeshPolyGraph* Graph)
+{
+	// Without a graph (e.g. mid-rebuild) keep what we have; dirty regions are removed separately
+	if (Graph && Graph->GetVersion() != GraphVersion)
+	{
+		Reset();
+		GraphVersion = Graph->GetVersion();
+	}
+}
+
+void FNavPointPool::Reset()
+{
+	Points.Reset();
+	Islands.Reset();
+	CenterIsland = INDEX_NONE;
+	bCenterResolved = false;
+	NextStratum = 0;
+}
@@ -0,0 +1,102 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AutoDriver/NavQueryCoalescer.h"
+
+FNavQueryCoalescer::FNavQueryCoalescer(float InTolerance, int32 InMaxQueriesPerFrame)
+	: ToleranceSquared(FMath::Square(FMath::Max(InTolerance, 0.0f)))
+	, CellSize(2.0f * FMath::Max(InTolerance, KINDA_SMALL_NUMBER))
+	, MaxQueriesPerFrame(FMath::Max(0, InMaxQueriesPerFrame))
+{
+}
+
+bool FNavQueryCoalescer::FindPath(const void* Scope, const FVector& From, const FVector& To, FNavigationQueryCache::FCacheEntry& OutEntry)
+{
+	SyncFrame();
+
+	// Same cells only: a within-tolerance query across a cell boundary just misses the coalescer
+	const TPair<FIntVector, FIntVector> Key(GetCell(From), GetCell(To));
+	for (TMultiMap<TPair<FIntVector, FIntVector>, int32>::TConstKeyIterator It = PathIndex.CreateConstKeyIterator(Key); It; ++It)
+	{
+		const FPathQuery& Query = PathQueries[It.Value()];
+		if (Query.Scope == Scope
+			&& FVector::DistSquared(Query.Entry.StartLocation, From) <= ToleranceSquared
+			&& FVector::DistSquared(Query.Entry.EndLocation, To) <= ToleranceSquared)
+		{
+			OutEntry = Query.Entry;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FNavQueryCoalescer::AddPath(const void* Scope, const FNavigationQueryCache::FCacheEntry& Entry)
+{
+	SyncFrame();
+
+	if (PathQueries.Num() >= MaxQueriesPerFrame)
+	{
+		return;
+	}
+
+	const int32 Index = PathQueries.Add({ Scope, Entry });
+	PathIndex.Add(TPair<FIntVector, FIntVector>(GetCell(Entry.StartLocation), GetCell(Entry.EndLocation)), Index);
+}
+
+bool FNavQueryCoalescer::FindProjection(const void* Scope, const FVector& Location, const FVector& Extent, FNavLocation& OutLocation, bool& bOutProjected)
+{
+	SyncFrame();
+
+	for (TMultiMap<FIntVector, int32>::TConstKeyIterator It = ProjectionIndex.CreateConstKeyIterator(GetCell(Location)); It; ++It)
+	{
+		const FProjectionQuery& Query = ProjectionQueries[It.Value()];
+		if (Query.Scope == Scope && Query.Location == Location && Query.Extent == Extent)
+		{
+			OutLocation = Query.Result;
+			bOutProjected = Query.bProjected;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FNavQueryCoalescer::AddProjection(const void* Scope, const FVector& Location, const FVector& Extent, const FNavLocation& Result, bool bProjected)
+{
+	SyncFrame();
+
+	if (ProjectionQueries.Num() >= MaxQueriesPerFrame)
+	{
+		return;
+	}
+
+	const int32 Index = ProjectionQueries.Add({ Scope, Location, Extent, Result, bProjected });
+	ProjectionIndex.Add(GetCell(Location), Index);
+}
+
+void FNavQueryCoalescer::SyncFrame()
+{
+	if (Frame == GFrameCounter)
+	{
+		return;
+	}
+
+	Frame = GFrameCounter;
+	Reset();
+}
+
+void FNavQueryCoalescer::Reset()
+{
+	PathQueries.Reset();
+	ProjectionQueries.Reset();
+	PathIndex.Reset();
+	ProjectionIndex.Reset();
+}
+
+FIntVector FNavQueryCoalescer::GetCell(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt32(Location.X / CellSize),
+		FMath::FloorToInt32(Location.Y / CellSize),
+		FMath::FloorToInt32(Location.Z / CellSize));
+}
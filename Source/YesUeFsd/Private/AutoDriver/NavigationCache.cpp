@@ -1,101 +1,574 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "AutoDriver/NavigationCache.h"
+#include "AutoDriver/AutoDriverStats.h"
 #include "HAL/PlatformTime.h"
+#include "Misc/ScopeRWLock.h"
 
-bool FNavigationQueryCache::FindCachedPath(const FVector& From, const FVector& To, FCacheEntry& OutEntry)
+FNavigationQueryCache::FNavigationQueryCache(int32 InMaxCacheSize, float InCacheTolerance, bool bInProbeNeighborCells, int32 InNumShards)
+	: MaxCacheSize(InMaxCacheSize)
+	, CacheTolerance(FMath::Max(InCacheTolerance, KINDA_SMALL_NUMBER))
+	, CellSize(2.0f * FMath::Max(InCacheTolerance, KINDA_SMALL_NUMBER))
+	, bProbeNeighborCells(bInProbeNeighborCells)
 {
-	FScopeLock Lock(&CacheMutex);
+	// Never create more shards than entries, otherwise small caches lose most of their capacity
+	const int32 NumShards = FMath::Clamp(InNumShards, 1, FMath::Max(1, MaxCacheSize));
+	const int32 EntriesPerShard = MaxCacheSize > 0 ? FMath::DivideAndRoundUp(MaxCacheSize, NumShards) : 0;
+
+	Shards.Reserve(NumShards);
+	AliasStripes.Reserve(NumShards);
+	GoalStripes.Reserve(NumShards);
+	for (int32 i = 0; i < NumShards; ++i)
+	{
+		TUniquePtr<FCacheShard>& Shard = Shards.Add_GetRef(MakeUnique<FCacheShard>());
+		Shard->MaxEntries = EntriesPerShard;
+		Shard->Owner = this;
+
+		AliasStripes.Add(MakeUnique<FKeyAliasStripe>());
+		GoalStripes.Add(MakeUnique<FGoalIndexStripe>());
+	}
+}
 
-	uint64 Key = GenerateCacheKey(From, To);
+FNavigationQueryCache::~FNavigationQueryCache()
+{
+	Clear();
+}
 
-	if (FCacheEntry* Entry = CacheEntries.Find(Key))
+bool FNavigationQueryCache::FindCachedPath(const FVector& From, const FVector& To, FCacheEntry& OutEntry)
+{
+	const FCacheKey Key = GenerateCacheKey(From, To);
+
+	auto LookUp = [this, &From, &To, &OutEntry](const FCacheKey& CandidateKey)
 	{
-		// Verify locations still match within tolerance
-		if (LocationsMatch(Entry->StartLocation, From) && LocationsMatch(Entry->EndLocation, To))
+		FCacheShard& Shard = GetShard(CandidateKey);
+		const EShardLookup Result = FindInShard(Shard, CandidateKey, From, To, OutEntry);
+
+		if (Result == EShardLookup::Stale)
 		{
-			// Check if cached path is still valid
-			if (Entry->IsStillValid())
+			// Readers cannot modify the shard; re-check under the write lock before removing
+			FWriteScopeLock WriteLock(Shard.Lock);
+			if (const int32* SlotIndex = Shard.KeyToSlot.Find(CandidateKey))
 			{
-				OutEntry = *Entry;
-				// Update timestamp for LRU
-				Entry->Timestamp = FPlatformTime::Seconds();
-				CacheHits++;
-				return true;
+				if (!Shard.Slots[*SlotIndex].Entry.IsStillValid())
+				{
+					Shard.RemoveEntry(CandidateKey);
+				}
 			}
-			else
+		}
+
+		return Result == EShardLookup::Hit;
+	};
+
+	bool bFound = LookUp(Key);
+
+	// Entries are also listed under every cell pair their endpoints' tolerance reaches, so the
+	// query's own cells name all remaining candidates in one alias lookup
+	if (!bFound && bProbeNeighborCells)
+	{
+		// Copy the keys out: shard locks are never taken while holding an alias lock
+		TArray<FCacheKey, TInlineAllocator<4>> Keys;
+		{
+			const FKeyAliasStripe& Stripe = GetAliasStripe(Key);
+			FReadScopeLock ReadLock(Stripe.Lock);
+			Stripe.AliasToKeys.MultiFind(Key, Keys);
+		}
+
+		for (int32 i = 0; i < Keys.Num() && !bFound; ++i)
+		{
+			bFound = LookUp(Keys[i]);
+		}
+	}
+
+	if (bFound)
+	{
+		CacheHits.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	CacheMisses.fetch_add(1, std::memory_order_relaxed);
+	return false;
+}
+
+FNavigationQueryCache::EShardLookup FNavigationQueryCache::FindInShard(const FCacheShard& Shard, const FCacheKey& Key, const FVector& From, const FVector& To, FCacheEntry& OutEntry) const
+{
+	FReadScopeLock ReadLock(Shard.Lock);
+
+	const int32* SlotIndex = Shard.KeyToSlot.Find(Key);
+	if (!SlotIndex)
+	{
+		return EShardLookup::Miss;
+	}
+
+	const FCacheSlot& Slot = Shard.Slots[*SlotIndex];
+
+	// Verify locations still match within tolerance
+	if (!LocationsMatch(Slot.Entry.StartLocation, From) || !LocationsMatch(Slot.Entry.EndLocation, To))
+	{
+		return EShardLookup::Miss;
+	}
+
+	// Check if cached path is still valid
+	if (!Slot.Entry.IsStillValid())
+	{
+		return EShardLookup::Stale;
+	}
+
+	OutEntry = Slot.Entry;
+
+	// Approximate recency: mark instead of relinking, and avoid dirtying the line when already set
+	if (!Slot.bReferenced.load(std::memory_order_relaxed))
+	{
+		Slot.bReferenced.store(true, std::memory_order_relaxed);
+	}
+
+	return EShardLookup::Hit;
+}
+
+bool FNavigationQueryCache::FindCachedSuffix(const FVector& From, const FVector& To, FSharedConstNavQueryFilter QueryFilter, FCacheEntry& OutEntry)
+{
+	// Goals are indexed under every cell their tolerance reaches, so To's own cell lists them all.
+	// Copy the keys out: shard locks are never taken while holding a goal index lock.
+	const FIntVector ToCell = GetCell(To);
+	TArray<FCacheKey, TInlineAllocator<16>> Keys;
+	{
+		const FGoalIndexStripe& Stripe = GetGoalStripe(ToCell);
+		FReadScopeLock ReadLock(Stripe.Lock);
+		Stripe.CellToKeys.MultiFind(ToCell, Keys);
+	}
+
+	for (const FCacheKey& Key : Keys)
+	{
+		if (FindSuffixForKey(Key, From, To, QueryFilter, OutEntry))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool FNavigationQueryCache::FindSuffixForKey(const FCacheKey& Key, const FVector& From, const FVector& To, const FSharedConstNavQueryFilter& QueryFilter, FCacheEntry& OutEntry) const
+{
+	const FCacheShard& Shard = GetShard(Key);
+
+	// Find the segment From lies on under the read lock; the raycast below runs without it
+	FCacheEntry Entry;
+	int32 SegmentEnd = INDEX_NONE;
+	{
+		FReadScopeLock ReadLock(Shard.Lock);
+
+		// The entry may have been evicted since the goal index was read
+		const int32* SlotIndex = Shard.KeyToSlot.Find(Key);
+		if (!SlotIndex)
+		{
+			return false;
+		}
+
+		const FCacheSlot& Slot = Shard.Slots[*SlotIndex];
+
+		// Only successful, up-to-date paths to this goal that come near From
+		if (!Slot.Entry.bIsValid || !Slot.Entry.IsStillValid() || !LocationsMatch(Slot.Entry.EndLocation, To)
+			|| !Slot.Entry.Bounds.ExpandBy(CacheTolerance).IsInside(From))
+		{
+			return false;
+		}
+
+		const float ToleranceSquared = CacheTolerance * CacheTolerance;
+		const TArray<FNavPathPoint>& Points = Slot.Entry.Path->GetPathPoints();
+		for (int32 i = 1; i < Points.Num(); ++i)
+		{
+			const FVector OnPath = FMath::ClosestPointOnSegment(From, Points[i - 1].Location, Points[i].Location);
+			if (FVector::DistSquared(OnPath, From) <= ToleranceSquared)
 			{
-				// Invalid entry, remove it
-				CacheEntries.Remove(Key);
+				SegmentEnd = i;
+				break;
 			}
 		}
+
+		if (SegmentEnd == INDEX_NONE)
+		{
+			return false;
+		}
+
+		Entry = Slot.Entry;
+
+		if (!Slot.bReferenced.load(std::memory_order_relaxed))
+		{
+			Slot.bReferenced.store(true, std::memory_order_relaxed);
+		}
 	}
 
-	CacheMisses++;
-	return false;
+	const TArray<FNavPathPoint>& Points = Entry.Path->GetPathPoints();
+
+	// Being near the path is not being on it: a wall or a ledge may separate From from the
+	// segment's end, so the new first leg must be walkable
+	const ANavigationData* NavData = Entry.Path->GetNavigationDataUsed();
+	FVector HitLocation;
+	if (!NavData || NavData->Raycast(From, Points[SegmentEnd].Location, HitLocation, QueryFilter))
+	{
+		return false;
+	}
+
+	// From, then everything past the segment it lies on
+	TSharedRef<FNavigationPath, ESPMode::ThreadSafe> Suffix = MakeShared<FNavigationPath, ESPMode::ThreadSafe>();
+	TArray<FNavPathPoint>& SuffixPoints = Suffix->GetPathPoints();
+	SuffixPoints.Reserve(Points.Num() - SegmentEnd + 1);
+	SuffixPoints.Add(FNavPathPoint(From, Points[SegmentEnd - 1].NodeRef));
+
+	float Length = 0.0f;
+	FVector Previous = From;
+	for (int32 k = SegmentEnd; k < Points.Num(); ++k)
+	{
+		SuffixPoints.Add(Points[k]);
+		Length += FVector::Dist(Previous, Points[k].Location);
+		Previous = Points[k].Location;
+	}
+
+	Suffix->SetNavigationDataUsed(NavData);
+	Suffix->MarkReady();
+
+	OutEntry = FCacheEntry(From, Entry.EndLocation, Suffix, Length, Entry.Timestamp);
+	return true;
 }
 
-void FNavigationQueryCache::CachePath(const FVector& From, const FVector& To, FNavigationPath* Path, float PathLength)
+void FNavigationQueryCache::CachePath(const FVector& From, const FVector& To, FNavPathSharedPtr Path, float PathLength)
 {
-	FScopeLock Lock(&CacheMutex);
+	if (MaxCacheSize <= 0)
+	{
+		return;
+	}
+
+	const FCacheKey Key = GenerateCacheKey(From, To);
+	FCacheShard& Shard = GetShard(Key);
+
+	FWriteScopeLock WriteLock(Shard.Lock);
+
+	// Replacing an existing entry must release its memory first
+	Shard.RemoveEntry(Key);
+
+	// Evict old entries if shard is full
+	if (Shard.KeyToSlot.Num() >= Shard.MaxEntries)
+	{
+		Shard.EvictOldestEntry();
+	}
 
-	// Evict old entries if cache is full
-	if (CacheEntries.Num() >= MaxCacheSize)
+	int32 SlotIndex;
+	if (Shard.FreeSlots.Num() > 0)
 	{
-		EvictOldestEntry();
+		SlotIndex = Shard.FreeSlots.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		SlotIndex = Shard.Slots.AddDefaulted();
 	}
 
-	uint64 Key = GenerateCacheKey(From, To);
-	double Timestamp = FPlatformTime::Seconds();
+	FCacheSlot& Slot = Shard.Slots[SlotIndex];
+	Slot.Key = Key;
+	Slot.Entry = FCacheEntry(From, To, MoveTemp(Path), PathLength, FPlatformTime::Seconds());
+	Slot.Entry.AccountedSize = Slot.Entry.GetAllocatedSize();
+	Slot.bReferenced.store(false, std::memory_order_relaxed);
 
-	CacheEntries.Add(Key, FCacheEntry(From, To, Path, PathLength, Timestamp));
+	Shard.KeyToSlot.Add(Key, SlotIndex);
+	Shard.LinkSlotAtHead(SlotIndex);
+	IndexEntry(Key, Slot.Entry, true);
+
+	Shard.AllocatedBytes += Slot.Entry.AccountedSize;
+	INC_MEMORY_STAT_BY(STAT_AutoDriver_NavCacheMemory, Slot.Entry.AccountedSize);
+}
+
+int32 FNavigationQueryCache::InvalidateInBounds(const FBox& DirtyBounds)
+{
+	// Path points lie on the navmesh surface, the agent corridor extends a little beyond them
+	const FBox ExpandedBounds = DirtyBounds.ExpandBy(CacheTolerance);
+	int32 NumRemoved = 0;
+
+	for (const TUniquePtr<FCacheShard>& Shard : Shards)
+	{
+		FWriteScopeLock WriteLock(Shard->Lock);
+
+		TArray<FCacheKey, TInlineAllocator<16>> AffectedKeys;
+		for (int32 SlotIndex = Shard->HeadSlot; SlotIndex != INDEX_NONE; SlotIndex = Shard->Slots[SlotIndex].Next)
+		{
+			const FCacheSlot& Slot = Shard->Slots[SlotIndex];
+			if (Slot.Entry.IsAffectedBy(ExpandedBounds))
+			{
+				AffectedKeys.Add(Slot.Key);
+			}
+		}
+
+		for (const FCacheKey& Key : AffectedKeys)
+		{
+			Shard->RemoveEntry(Key);
+		}
+		NumRemoved += AffectedKeys.Num();
+	}
+
+	return NumRemoved;
+}
+
+void FNavigationQueryCache::ForEachEntry(TFunctionRef<void(const FCacheEntry&)> Visitor) const
+{
+	for (const TUniquePtr<FCacheShard>& Shard : Shards)
+	{
+		FReadScopeLock ReadLock(Shard->Lock);
+
+		// Oldest first, so re-inserting in visit order preserves recency
+		for (int32 SlotIndex = Shard->TailSlot; SlotIndex != INDEX_NONE; SlotIndex = Shard->Slots[SlotIndex].Prev)
+		{
+			Visitor(Shard->Slots[SlotIndex].Entry);
+		}
+	}
 }
 
 void FNavigationQueryCache::Clear()
 {
-	FScopeLock Lock(&CacheMutex);
-	CacheEntries.Empty();
-	CacheHits = 0;
-	CacheMisses = 0;
+	for (const TUniquePtr<FCacheShard>& Shard : Shards)
+	{
+		FWriteScopeLock WriteLock(Shard->Lock);
+		Shard->Empty();
+	}
+
+	for (const TUniquePtr<FKeyAliasStripe>& Stripe : AliasStripes)
+	{
+		FWriteScopeLock WriteLock(Stripe->Lock);
+		Stripe->AliasToKeys.Empty();
+	}
+
+	for (const TUniquePtr<FGoalIndexStripe>& Stripe : GoalStripes)
+	{
+		FWriteScopeLock WriteLock(Stripe->Lock);
+		Stripe->CellToKeys.Empty();
+	}
+
+	ResetStats();
+}
+
+void FNavigationQueryCache::GetCacheStats(int32& OutHits, int32& OutMisses, int32& OutEntries) const
+{
+	OutHits = CacheHits.load(std::memory_order_relaxed);
+	OutMisses = CacheMisses.load(std::memory_order_relaxed);
+	OutEntries = 0;
+
+	for (const TUniquePtr<FCacheShard>& Shard : Shards)
+	{
+		FReadScopeLock ReadLock(Shard->Lock);
+		OutEntries += Shard->KeyToSlot.Num();
+	}
+}
+
+FNavigationQueryCache::FCacheKey FNavigationQueryCache::GenerateCacheKey(const FVector& From, const FVector& To) const
+{
+	return FCacheKey{ GetCell(From), GetCell(To) };
 }
 
-uint64 FNavigationQueryCache::GenerateCacheKey(const FVector& From, const FVector& To) const
+FIntVector FNavigationQueryCache::GetCell(const FVector& Location) const
 {
-	// Round to tolerance to improve cache hits for nearby queries
-	FVector RoundedFrom = (From / CacheTolerance).GridSnap(1.0f) * CacheTolerance;
-	FVector RoundedTo = (To / CacheTolerance).GridSnap(1.0f) * CacheTolerance;
+	return FIntVector(
+		FMath::FloorToInt32(Location.X / CellSize),
+		FMath::FloorToInt32(Location.Y / CellSize),
+		FMath::FloorToInt32(Location.Z / CellSize));
+}
+
+int32 FNavigationQueryCache::GetReachedCells(const FVector& Location, FIntVector OutCells[8]) const
+{
+	const FIntVector Cell = GetCell(Location);
+	OutCells[0] = Cell;
+
+	if (!bProbeNeighborCells)
+	{
+		return 1;
+	}
+
+	// With cells twice the tolerance wide, the tolerance sphere can only reach the neighbours on
+	// the side of the cell centre the point is closer to; keep those it actually reaches
+	const FVector Offset = Location - FVector(Cell) * CellSize;
+	FIntVector Step;
+	FVector Gap;
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		const bool bLower = Offset[Axis] < CacheTolerance;
+		Step[Axis] = bLower ? -1 : 1;
+		Gap[Axis] = bLower ? Offset[Axis] : CellSize - Offset[Axis];
+	}
 
-	// Simple hash combination
-	uint64 Hash = 0;
-	Hash ^= GetTypeHash(RoundedFrom.X);
-	Hash ^= (uint64(GetTypeHash(RoundedFrom.Y)) << 16);
-	Hash ^= (uint64(GetTypeHash(RoundedFrom.Z)) << 32);
-	Hash ^= (uint64(GetTypeHash(RoundedTo.X)) << 8);
-	Hash ^= (uint64(GetTypeHash(RoundedTo.Y)) << 24);
-	Hash ^= (uint64(GetTypeHash(RoundedTo.Z)) << 40);
+	const double ToleranceSquared = FMath::Square(CacheTolerance);
+	int32 NumCells = 1;
+	for (int32 Mask = 1; Mask < 8; ++Mask)
+	{
+		const double DistanceSquared =
+			((Mask & 1) ? FMath::Square(Gap.X) : 0.0) +
+			((Mask & 2) ? FMath::Square(Gap.Y) : 0.0) +
+			((Mask & 4) ? FMath::Square(Gap.Z) : 0.0);
+
+		if (DistanceSquared <= ToleranceSquared)
+		{
+			OutCells[NumCells++] = FIntVector(
+				Cell.X + ((Mask & 1) ? Step.X : 0),
+				Cell.Y + ((Mask & 2) ? Step.Y : 0),
+				Cell.Z + ((Mask & 4) ? Step.Z : 0));
+		}
+	}
 
-	return Hash;
+	return NumCells;
 }
 
-void FNavigationQueryCache::EvictOldestEntry()
+void FNavigationQueryCache::IndexEntry(const FCacheKey& Key, const FCacheEntry& Entry, bool bAdd) const
 {
-	if (CacheEntries.Num() == 0)
+	FIntVector FromCells[8];
+	FIntVector ToCells[8];
+	const int32 NumFromCells = GetReachedCells(Entry.StartLocation, FromCells);
+	const int32 NumToCells = GetReachedCells(Entry.EndLocation, ToCells);
+
+	// Every other cell pair a matching query may produce names this key
+	for (int32 ToIndex = 0; ToIndex < NumToCells; ++ToIndex)
 	{
-		return;
+		for (int32 FromIndex = 0; FromIndex < NumFromCells; ++FromIndex)
+		{
+			const FCacheKey Alias{ FromCells[FromIndex], ToCells[ToIndex] };
+			if (Alias == Key)
+			{
+				continue;
+			}
+
+			FKeyAliasStripe& Stripe = GetAliasStripe(Alias);
+			FWriteScopeLock StripeLock(Stripe.Lock);
+			if (bAdd)
+			{
+				Stripe.AliasToKeys.Add(Alias, Key);
+			}
+			else
+			{
+				Stripe.AliasToKeys.RemoveSingle(Alias, Key);
+			}
+		}
 	}
 
-	// Find entry with oldest timestamp
-	uint64 OldestKey = 0;
-	double OldestTime = TNumericLimits<double>::Max();
+	// Goal index: every cell a goal within tolerance may fall in
+	for (int32 ToIndex = 0; ToIndex < NumToCells; ++ToIndex)
+	{
+		FGoalIndexStripe& Stripe = GetGoalStripe(ToCells[ToIndex]);
+		FWriteScopeLock StripeLock(Stripe.Lock);
+		if (bAdd)
+		{
+			Stripe.CellToKeys.Add(ToCells[ToIndex], Key);
+		}
+		else
+		{
+			Stripe.CellToKeys.RemoveSingle(ToCells[ToIndex], Key);
+		}
+	}
+}
+
+FNavigationQueryCache::FCacheShard& FNavigationQueryCache::GetShard(const FCacheKey& Key) const
+{
+	return *Shards[GetTypeHash(Key) % static_cast<uint32>(Shards.Num())];
+}
+
+FNavigationQueryCache::FKeyAliasStripe& FNavigationQueryCache::GetAliasStripe(const FCacheKey& Alias) const
+{
+	return *AliasStripes[GetTypeHash(Alias) % static_cast<uint32>(AliasStripes.Num())];
+}
+
+FNavigationQueryCache::FGoalIndexStripe& FNavigationQueryCache::GetGoalStripe(const FIntVector& ToCell) const
+{
+	return *GoalStripes[GetTypeHash(ToCell) % static_cast<uint32>(GoalStripes.Num())];
+}
 
-	for (const auto& Pair : CacheEntries)
+void FNavigationQueryCache::FCacheShard::EvictOldestEntry()
+{
+	// Second chance: referenced entries at the tail are cleared and moved to the head.
+	// Every pass clears a bit, so this terminates within one lap of the list.
+	for (int32 Remaining = KeyToSlot.Num(); TailSlot != INDEX_NONE && Remaining > 0; --Remaining)
 	{
-		if (Pair.Value.Timestamp < OldestTime)
+		const int32 SlotIndex = TailSlot;
+		if (!Slots[SlotIndex].bReferenced.exchange(false, std::memory_order_relaxed))
 		{
-			OldestTime = Pair.Value.Timestamp;
-			OldestKey = Pair.Key;
+			break;
 		}
+
+		UnlinkSlot(SlotIndex);
+		LinkSlotAtHead(SlotIndex);
+	}
+
+	if (TailSlot != INDEX_NONE)
+	{
+		RemoveEntry(Slots[TailSlot].Key);
+	}
+}
+
+void FNavigationQueryCache::FCacheShard::RemoveEntry(const FCacheKey& Key)
+{
+	int32 SlotIndex = INDEX_NONE;
+	if (!KeyToSlot.RemoveAndCopyValue(Key, SlotIndex))
+	{
+		return;
+	}
+
+	FCacheSlot& Slot = Slots[SlotIndex];
+	Owner->IndexEntry(Key, Slot.Entry, false);
+
+	AllocatedBytes -= Slot.Entry.AccountedSize;
+	DEC_MEMORY_STAT_BY(STAT_AutoDriver_NavCacheMemory, Slot.Entry.AccountedSize);
+
+	UnlinkSlot(SlotIndex);
+
+	// Release the path reference now rather than when the slot is reused
+	Slot.Entry = FCacheEntry();
+	Slot.bReferenced.store(false, std::memory_order_relaxed);
+	FreeSlots.Add(SlotIndex);
+}
+
+void FNavigationQueryCache::FCacheShard::UnlinkSlot(int32 SlotIndex)
+{
+	FCacheSlot& Slot = Slots[SlotIndex];
+
+	if (Slot.Prev != INDEX_NONE)
+	{
+		Slots[Slot.Prev].Next = Slot.Next;
+	}
+	else
+	{
+		HeadSlot = Slot.Next;
+	}
+
+	if (Slot.Next != INDEX_NONE)
+	{
+		Slots[Slot.Next].Prev = Slot.Prev;
 	}
+	else
+	{
+		TailSlot = Slot.Prev;
+	}
+
+	Slot.Prev = INDEX_NONE;
+	Slot.Next = INDEX_NONE;
+}
+
+void FNavigationQueryCache::FCacheShard::LinkSlotAtHead(int32 SlotIndex)
+{
+	FCacheSlot& Slot = Slots[SlotIndex];
+	Slot.Prev = INDEX_NONE;
+	Slot.Next = HeadSlot;
+
+	if (HeadSlot != INDEX_NONE)
+	{
+		Slots[HeadSlot].Prev = SlotIndex;
+	}
+	HeadSlot = SlotIndex;
 
-	CacheEntries.Remove(OldestKey);
+	if (TailSlot == INDEX_NONE)
+	{
+		TailSlot = SlotIndex;
+	}
+}
+
+void FNavigationQueryCache::FCacheShard::Empty()
+{
+	Slots.Empty();
+	KeyToSlot.Empty();
+	FreeSlots.Empty();
+	HeadSlot = INDEX_NONE;
+	TailSlot = INDEX_NONE;
+	DEC_MEMORY_STAT_BY(STAT_AutoDriver_NavCacheMemory, AllocatedBytes);
+	AllocatedBytes = 0;
 }
@@ -0,0 +1,317 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AutoDriver/NavigationCache.h"
+#include "AutoDriver/NavigationHelper.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+
+#if !UE_BUILD_SHIPPING
+
+namespace NavCacheBenchmark
+{
+	/** Build distinct query endpoints spread far enough apart to never share a cache key */
+	void GenerateQueries(int32 Count, TArray<FVector>& OutFrom, TArray<FVector>& OutTo)
+	{
+		FRandomStream Random(1234);
+
+		OutFrom.SetNum(Count);
+		OutTo.SetNum(Count);
+		for (int32 i = 0; i < Count; ++i)
+		{
+			OutFrom[i] = FVector(i * 1000.0f, Random.FRandRange(-50000.0f, 50000.0f), 0.0f);
+			OutTo[i] = FVector(Random.FRandRange(-50000.0f, 50000.0f), i * 1000.0f, 100.0f);
+		}
+	}
+
+	void RunCapacity(int32 Capacity)
+	{
+		const int32 NumInserts = FMath::Max(Capacity * 2, 10000);
+		const int32 NumFinds = FMath::Max(Capacity, 100000);
+
+		TArray<FVector> From;
+		TArray<FVector> To;
+		GenerateQueries(NumInserts, From, To);
+
+		FNavigationQueryCache Cache(Capacity, 100.0f);
+
+		// Inserts past capacity exercise the eviction path
+		const double InsertStart = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumInserts; ++i)
+		{
+			Cache.CachePath(From[i], To[i], nullptr, 0.0f);
+		}
+		const double InsertSeconds = FPlatformTime::Seconds() - InsertStart;
+
+		// Finds target the resident (most recent) entries
+		FRandomStream Random(5678);
+		const int32 FirstResident = NumInserts - Capacity;
+		FNavigationQueryCache::FCacheEntry Entry;
+		int32 Found = 0;
+
+		const double FindStart = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumFinds; ++i)
+		{
+			const int32 Index = Random.RandRange(FirstResident, NumInserts - 1);
+			Found += Cache.FindCachedPath(From[Index], To[Index], Entry) ? 1 : 0;
+		}
+		const double FindSeconds = FPlatformTime::Seconds() - FindStart;
+
+		UE_LOG(LogTemp, Log, TEXT("NavCache Benchmark: Capacity %7d | Insert %8.2f Mops/s (%d ops) | Find %8.2f Mops/s (%d ops, %d hits)"),
+			Capacity,
+			NumInserts / FMath::Max(InsertSeconds, SMALL_NUMBER) / 1.0e6,
+			NumInserts,
+			NumFinds / FMath::Max(FindSeconds, SMALL_NUMBER) / 1.0e6,
+			NumFinds,
+			Found);
+	}
+
+	void Run(const TArray<FString>& Args)
+	{
+		TArray<int32> Capacities;
+		for (const FString& Arg : Args)
+		{
+			const int32 Capacity = FCString::Atoi(*Arg);
+			if (Capacity > 0)
+			{
+				Capacities.Add(Capacity);
+			}
+		}
+
+		if (Capacities.Num() == 0)
+		{
+			Capacities = { 128, 1000, 10000, 100000 };
+		}
+
+		for (int32 Capacity : Capacities)
+		{
+			RunCapacity(Capacity);
+		}
+	}
+}
+
+namespace NavCacheTraceReplay
+{
+	/**
+	 * Load a query trace: one "FromX,FromY,FromZ,ToX,ToY,ToZ" line per query.
+	 * Without a file, synthesises repeated queries jittered within half the tolerance.
+	 */
+	bool LoadTrace(const FString& FilePath, float Tolerance, TArray<TPair<FVector, FVector>>& OutQueries)
+	{
+		if (!FilePath.IsEmpty())
+		{
+			TArray<FString> Lines;
+			if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath))
+			{
+				UE_LOG(LogTemp, Error, TEXT("NavCache Replay: Could not read trace %s"), *FilePath);
+				return false;
+			}
+
+			for (const FString& Line : Lines)
+			{
+				TArray<FString> Values;
+				if (Line.ParseIntoArray(Values, TEXT(",")) == 6)
+				{
+					OutQueries.Emplace(
+						FVector(FCString::Atod(*Values[0]), FCString::Atod(*Values[1]), FCString::Atod(*Values[2])),
+						FVector(FCString::Atod(*Values[3]), FCString::Atod(*Values[4]), FCString::Atod(*Values[5])));
+				}
+			}
+			return OutQueries.Num() > 0;
+		}
+
+		FRandomStream Random(4321);
+		const int32 NumRoutes = 500;
+		const int32 NumQueries = 50000;
+
+		TArray<TPair<FVector, FVector>> Routes;
+		for (int32 i = 0; i < NumRoutes; ++i)
+		{
+			Routes.Emplace(
+				FVector(Random.FRandRange(-50000.0f, 50000.0f), Random.FRandRange(-50000.0f, 50000.0f), 0.0f),
+				FVector(Random.FRandRange(-50000.0f, 50000.0f), Random.FRandRange(-50000.0f, 50000.0f), 0.0f));
+		}
+
+		for (int32 i = 0; i < NumQueries; ++i)
+		{
+			const TPair<FVector, FVector>& Route = Routes[Random.RandRange(0, NumRoutes - 1)];
+			OutQueries.Emplace(
+				Route.Key + Random.GetUnitVector() * Random.FRandRange(0.0f, Tolerance * 0.5f),
+				Route.Value + Random.GetUnitVector() * Random.FRandRange(0.0f, Tolerance * 0.5f));
+		}
+		return true;
+	}
+
+	/** Replay queries, inserting on every miss, and return the hit rate */
+	float Replay(const TArray<TPair<FVector, FVector>>& Queries, float Tolerance, bool bProbeNeighborCells)
+	{
+		FNavigationQueryCache Cache(Queries.Num(), Tolerance, bProbeNeighborCells);
+		FNavigationQueryCache::FCacheEntry Entry;
+
+		for (const TPair<FVector, FVector>& Query : Queries)
+		{
+			if (!Cache.FindCachedPath(Query.Key, Query.Value, Entry))
+			{
+				Cache.CachePath(Query.Key, Query.Value, nullptr, 0.0f);
+			}
+		}
+
+		int32 Hits, Misses, Entries;
+		Cache.GetCacheStats(Hits, Misses, Entries);
+		return Hits / FMath::Max(1.0f, static_cast<float>(Hits + Misses));
+	}
+
+	void Run(const TArray<FString>& Args)
+	{
+		const FString FilePath = Args.Num() > 0 ? Args[0] : FString();
+		const float Tolerance = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 100.0f;
+
+		TArray<TPair<FVector, FVector>> Queries;
+		if (!LoadTrace(FilePath, Tolerance, Queries))
+		{
+			return;
+		}
+
+		const float ExactHitRate = Replay(Queries, Tolerance, false);
+		const float AliasHitRate = Replay(Queries, Tolerance, true);
+
+		UE_LOG(LogTemp, Log, TEXT("NavCache Replay: %d queries (%s), tolerance %.1f | Exact cell: %.1f%% hits | Neighbour aliases: %.1f%% hits"),
+			Queries.Num(), FilePath.IsEmpty() ? TEXT("synthetic") : *FilePath, Tolerance,
+			ExactHitRate * 100.0f, AliasHitRate * 100.0f);
+	}
+}
+
+namespace NavCacheContention
+{
+	/** Run a read-mostly mixed workload (1 insert per 16 lookups) from NumThreads workers */
+	void RunShards(int32 NumShards, int32 NumThreads, const TArray<FVector>& From, const TArray<FVector>& To)
+	{
+		const int32 Capacity = From.Num() / 2;
+		const int32 OpsPerThread = 200000;
+
+		FNavigationQueryCache Cache(Capacity, 100.0f, true, NumShards);
+		for (int32 i = 0; i < Capacity; ++i)
+		{
+			Cache.CachePath(From[i], To[i], nullptr, 0.0f);
+		}
+
+		const double Start = FPlatformTime::Seconds();
+		ParallelFor(NumThreads, [&](int32 ThreadIndex)
+		{
+			FRandomStream Random(ThreadIndex + 1);
+			FNavigationQueryCache::FCacheEntry Entry;
+
+			for (int32 i = 0; i < OpsPerThread; ++i)
+			{
+				const int32 Index = Random.RandRange(0, From.Num() - 1);
+				if ((i & 15) == 0)
+				{
+					Cache.CachePath(From[Index], To[Index], nullptr, 0.0f);
+				}
+				else
+				{
+					Cache.FindCachedPath(From[Index], To[Index], Entry);
+				}
+			}
+		}, EParallelForFlags::Unbalanced);
+		const double Seconds = FPlatformTime::Seconds() - Start;
+
+		int32 Hits, Misses, Entries;
+		Cache.GetCacheStats(Hits, Misses, Entries);
+
+		UE_LOG(LogTemp, Log, TEXT("NavCache Contention: %2d shards | %2d threads | %8.2f Mops/s | %.1f%% hits"),
+			NumShards,
+			NumThreads,
+			static_cast<double>(NumThreads) * OpsPerThread / FMath::Max(Seconds, SMALL_NUMBER) / 1.0e6,
+			Hits * 100.0f / FMath::Max(1, Hits + Misses));
+	}
+
+	void Run(const TArray<FString>& Args)
+	{
+		const int32 NumThreads = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : FPlatformMisc::NumberOfWorkerThreadsToSpawn();
+		const int32 NumShards = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 16;
+
+		TArray<FVector> From;
+		TArray<FVector> To;
+		NavCacheBenchmark::GenerateQueries(8192, From, To);
+
+		// A single shard is the old global-lock behaviour
+		RunShards(1, NumThreads, From, To);
+		RunShards(NumShards, NumThreads, From, To);
+	}
+}
+
+namespace NavProjectionBenchmark
+{
+	/** Project random points inside the navmesh bounds one call at a time, then as one batch */
+	void Run(const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 NumPoints = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000;
+		const FVector Extent(500.0f, 500.0f, 500.0f);
+
+		UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+		const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance() : nullptr;
+		if (!NavData)
+		{
+			UE_LOG(LogTemp, Error, TEXT("NavProjection Benchmark: No navigation data in this world"));
+			return;
+		}
+
+		const FBox Bounds = NavData->GetBounds();
+		FRandomStream Random(2468);
+		TArray<FVector> Points;
+		Points.Reserve(NumPoints);
+		for (int32 i = 0; i < NumPoints; ++i)
+		{
+			Points.Add(Random.RandPointInBox(Bounds));
+		}
+
+		const double SingleStart = FPlatformTime::Seconds();
+		int32 SingleProjected = 0;
+		for (const FVector& Point : Points)
+		{
+			SingleProjected += UNavigationHelper::IsLocationOnNavMesh(World, Point, Extent) ? 1 : 0;
+		}
+		const double SingleSeconds = FPlatformTime::Seconds() - SingleStart;
+
+		TArray<FVector> Projected;
+		TArray<bool> bProjected;
+		const double BatchStart = FPlatformTime::Seconds();
+		const int32 BatchProjected = UNavigationHelper::ProjectLocationsToNavMesh(World, Points, Projected, bProjected, Extent);
+		const double BatchSeconds = FPlatformTime::Seconds() - BatchStart;
+
+		UE_LOG(LogTemp, Log, TEXT("NavProjection Benchmark: %d points | Per call %8.3f M points/s (%d projected) | Batch %8.3f M points/s (%d projected) | %.1fx"),
+			NumPoints,
+			NumPoints / FMath::Max(SingleSeconds, SMALL_NUMBER) / 1.0e6, SingleProjected,
+			NumPoints / FMath::Max(BatchSeconds, SMALL_NUMBER) / 1.0e6, BatchProjected,
+			SingleSeconds / FMath::Max(BatchSeconds, SMALL_NUMBER));
+	}
+}
+
+static FAutoConsoleCommand NavCacheBenchmarkCommand(
+	TEXT("AutoDriver.NavCache.Benchmark"),
+	TEXT("Measure navigation cache insert/find throughput. Usage: AutoDriver.NavCache.Benchmark [Capacity ...]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&NavCacheBenchmark::Run));
+
+static FAutoConsoleCommand NavCacheReplayTraceCommand(
+	TEXT("AutoDriver.NavCache.ReplayTrace"),
+	TEXT("Compare cache hit rates with and without neighbour-cell probing. Usage: AutoDriver.NavCache.ReplayTrace [TraceCsv] [Tolerance]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&NavCacheTraceReplay::Run));
+
+static FAutoConsoleCommand NavCacheContentionCommand(
+	TEXT("AutoDriver.NavCache.Contention"),
+	TEXT("Measure navigation cache throughput under concurrent lookups, single lock vs sharded. Usage: AutoDriver.NavCache.Contention [Threads] [Shards]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&NavCacheContention::Run));
+
+static FAutoConsoleCommandWithWorldAndArgs NavProjectionBenchmarkCommand(
+	TEXT("AutoDriver.Nav.ProjectBenchmark"),
+	TEXT("Compare per-call and batched navmesh projection throughput. Usage: AutoDriver.Nav.ProjectBenchmark [NumPoints]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&NavProjectionBenchmark::Run));
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,933 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AutoDriver/NavigationCacheSubsystem.h"
+#include "AutoDriver/NavigationCache.h"
+#include "AutoDriver/NavMeshPolyGraph.h"
+#include "AutoDriver/NavGoalTree.h"
+#include "AutoDriver/NavClusterGraph.h"
+#include "AutoDriver/NavPointPool.h"
+#include "AutoDriver/NavQueryCoalescer.h"
+#include "AutoDriver/NavPathScheduler.h"
+#include "AutoDriver/NavDebugOverlay.h"
+#include "AutoDriver/AutoDriverStats.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "Components/LineBatchComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeRWLock.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/SoftObjectPath.h"
+
+namespace NavCachePersistence
+{
+	/** "ADNC" */
+	constexpr uint32 FileMagic = 0x434E4441;
+	constexpr int32 FileVersion = 1;
+
+	/** Smallest serialized size of a cache header (two empty strings, hash, entry count) */
+	constexpr int64 MinCacheSize = 4 * sizeof(int32);
+
+	/** Smallest serialized size of an entry (endpoints, validity, length, point count) */
+	constexpr int64 MinEntrySize = 2 * sizeof(FVector) + sizeof(uint32) + sizeof(float) + sizeof(int32);
+
+	/** Serialized size of a path point */
+	constexpr int64 PointSize = sizeof(FVector) + sizeof(NavNodeRef);
+
+	/** Whether Count elements of at least ElementSize bytes each can still follow in the file */
+	bool IsCountPlausible(const FArchive& Reader, int32 Count, int64 ElementSize)
+	{
+		return Count >= 0 && Count <= (Reader.TotalSize() - Reader.Tell()) / ElementSize;
+	}
+}
+
+UNavigationCacheSubsystem::UNavigationCacheSubsystem() = default;
+
+// Out of line so TUniquePtr<FNavigationQueryCache> only needs the complete type here
+UNavigationCacheSubsystem::~UNavigationCacheSubsystem() = default;
+
+UNavigationCacheSubsystem* UNavigationCacheSubsystem::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UNavigationCacheSubsystem>() : nullptr;
+}
+
+void UNavigationCacheSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	NavigationDirtyHandle = UNavigationSystemV1::NavigationDirtyEvent.AddUObject(this, &UNavigationCacheSubsystem::OnNavigationDirtied);
+
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.AddUniqueDynamic(this, &UNavigationCacheSubsystem::OnNavigationGenerationFinished);
+	}
+
+	if (bPersistentCache)
+	{
+		LoadPersistentCaches();
+	}
+}
+
+void UNavigationCacheSubsystem::Deinitialize()
+{
+	if (bPersistentCache)
+	{
+		SavePersistentCaches();
+	}
+
+	UNavigationSystemV1::NavigationDirtyEvent.Remove(NavigationDirtyHandle);
+	NavigationDirtyHandle.Reset();
+
+	if (UWorld* World = GetWorld())
+	{
+		if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World))
+		{
+			NavSys->OnNavigationGenerationFinishedDelegate.RemoveDynamic(this, &UNavigationCacheSubsystem::OnNavigationGenerationFinished);
+		}
+	}
+
+	PendingDirtyBounds.Empty();
+
+	{
+		FWriteScopeLock WriteLock(CachesLock);
+		Caches.Empty();
+	}
+
+	ReleaseDebugOverlay();
+	QueryCoalescer.Reset();
+	PathScheduler.Reset();
+	PointPools.Empty();
+	ClusterGraphs.Empty();
+	GoalTrees.Empty();
+	PolyGraphs.Empty();
+
+	Super::Deinitialize();
+}
+
+void UNavigationCacheSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (bAwaitingNavigationRebuild)
+	{
+		SettleDirtyNavigation();
+	}
+
+	// Goal trees and cluster graphs share the time-slicing budget; without one they are built at once
+	const double BudgetSeconds = PathfindingBudgetMs * 0.001;
+	const double Deadline = BudgetSeconds > 0.0 ? FPlatformTime::Seconds() + BudgetSeconds : TNumericLimits<double>::Max();
+
+	if (PathScheduler.IsValid())
+	{
+		PathScheduler->Tick(BudgetSeconds, [this](const ANavigationData* NavData) -> const FNavMeshPolyGraph*
+		{
+			return GetPolyGraph(NavData);
+		});
+	}
+
+	BuildPendingGoalTrees(Deadline);
+	BuildPendingClusterGraphs(Deadline);
+
+	if (DebugOverlay.IsValid())
+	{
+		if (FNavDebugOverlay::IsEnabled() && DebugLineBatcher)
+		{
+			DebugOverlay->Flush(*DebugLineBatcher, GetWorld()->GetTimeSeconds());
+		}
+		else
+		{
+			ReleaseDebugOverlay();
+		}
+	}
+
+	if (PointPools.Num() == 0)
+	{
+		return;
+	}
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (!NavSys || NavSys->IsNavigationBuildInProgress())
+	{
+		return;
+	}
+
+	// Pools nobody drew from for a few seconds are not worth topping up
+	const uint64 MaxIdleFrames = 300;
+
+	int32 Budget = PointPoolSamplesPerFrame;
+	for (const TPair<FPointPoolKey, TUniquePtr<FNavPointPool>>& Pair : PointPools)
+	{
+		if (Budget <= 0)
+		{
+			break;
+		}
+
+		FNavPointPool& Pool = *Pair.Value;
+		if (!Pool.NeedsRefill() || GFrameCounter - Pool.LastUsedFrame > MaxIdleFrames)
+		{
+			continue;
+		}
+
+		if (const ANavigationData* NavData = Cast<ANavigationData>(Pair.Key.NavData.ResolveObjectPtr()))
+		{
+			Budget -= Pool.Refill(*NavData, GetPolyGraph(NavData), Budget);
+		}
+	}
+}
+
+TStatId UNavigationCacheSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNavigationCacheSubsystem, STATGROUP_Tickables);
+}
+
+bool UNavigationCacheSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+FNavigationQueryCache& UNavigationCacheSubsystem::GetCache(const ANavigationData* NavData, TSubclassOf<UNavigationQueryFilter> FilterClass)
+{
+	const TPair<FObjectKey, FObjectKey> Key(FObjectKey(NavData), FObjectKey(FilterClass.Get()));
+
+	{
+		FReadScopeLock ReadLock(CachesLock);
+		if (const FCacheInstance* Instance = Caches.Find(Key))
+		{
+			return *Instance->Cache;
+		}
+	}
+
+	FWriteScopeLock WriteLock(CachesLock);
+	FCacheInstance& Instance = Caches.FindOrAdd(Key);
+	if (!Instance.Cache.IsValid())
+	{
+		Instance.Cache = MakeUnique<FNavigationQueryCache>(MaxEntriesPerCache, CacheTolerance);
+		Instance.Label = FString::Printf(TEXT("%s / %s"),
+			NavData ? *NavData->GetName() : TEXT("None"),
+			FilterClass ? *FilterClass->GetName() : TEXT("DefaultFilter"));
+		Instance.NavDataName = NavData ? NavData->GetName() : FString();
+		Instance.FilterClassPath = FilterClass ? FilterClass->GetPathName() : FString();
+	}
+	return *Instance.Cache;
+}
+
+FNavMeshPolyGraph* UNavigationCacheSubsystem::GetPolyGraph(const ANavigationData* NavData)
+{
+	check(IsInGameThread());
+
+	if (!NavData)
+	{
+		return nullptr;
+	}
+
+	// Never extract a half-built navmesh
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (!NavSys || NavSys->IsNavigationBuildInProgress())
+	{
+		return nullptr;
+	}
+
+	TUniquePtr<FNavMeshPolyGraph>* Existing = PolyGraphs.Find(FObjectKey(NavData));
+	if (!Existing)
+	{
+		TUniquePtr<FNavMeshPolyGraph> Graph = MakeUnique<FNavMeshPolyGraph>();
+		if (!Graph->Build(*NavData))
+		{
+			Graph.Reset();
+		}
+		Existing = &PolyGraphs.Add(FObjectKey(NavData), MoveTemp(Graph));
+	}
+
+	FNavMeshPolyGraph* Graph = Existing->Get();
+	return Graph && Graph->IsReady() ? Graph : nullptr;
+}
+
+FNavGoalTreeCache* UNavigationCacheSubsystem::GetGoalTrees(const ANavigationData* NavData)
+{
+	check(IsInGameThread());
+
+	if (!bUseGoalTrees || !NavData)
+	{
+		return nullptr;
+	}
+
+	TUniquePtr<FNavGoalTreeCache>& Trees = GoalTrees.FindOrAdd(FObjectKey(NavData));
+	if (!Trees.IsValid())
+	{
+		Trees = MakeUnique<FNavGoalTreeCache>(MaxGoalTreesPerNavData, MinRequestsForGoalTree);
+	}
+	return Trees.Get();
+}
+
+void UNavigationCacheSubsystem::BuildPendingGoalTrees(double Deadline)
+{
+	for (const TPair<FObjectKey, TUniquePtr<FNavGoalTreeCache>>& Pair : GoalTrees)
+	{
+		if (!Pair.Value.IsValid() || !Pair.Value->HasPendingBuilds())
+		{
+			continue;
+		}
+
+		const ANavigationData* NavData = Cast<ANavigationData>(Pair.Key.ResolveObjectPtr());
+		if (const FNavMeshPolyGraph* Graph = GetPolyGraph(NavData))
+		{
+			Pair.Value->BuildPending(*Graph, Deadline);
+		}
+	}
+}
+
+const FNavClusterGraph* UNavigationCacheSubsystem::GetClusterGraph(const ANavigationData* NavData)
+{
+	check(IsInGameThread());
+
+	const FNavMeshPolyGraph* Graph = bUseClusterGraph ? GetPolyGraph(NavData) : nullptr;
+	if (!Graph)
+	{
+		return nullptr;
+	}
+
+	// A stale graph is replaced by a fresh build, which Tick advances within the frame budget
+	TUniquePtr<FNavClusterGraph>& Clusters = ClusterGraphs.FindOrAdd(FObjectKey(NavData));
+	if (!Clusters.IsValid() || !Clusters->IsValidFor(*Graph))
+	{
+		Clusters = MakeUnique<FNavClusterGraph>(*Graph, ClusterSize);
+	}
+	return Clusters->IsComplete() ? Clusters.Get() : nullptr;
+}
+
+void UNavigationCacheSubsystem::BuildPendingClusterGraphs(double Deadline)
+{
+	for (const TPair<FObjectKey, TUniquePtr<FNavClusterGraph>>& Pair : ClusterGraphs)
+	{
+		if (!Pair.Value.IsValid() || Pair.Value->IsComplete())
+		{
+			continue;
+		}
+
+		const ANavigationData* NavData = Cast<ANavigationData>(Pair.Key.ResolveObjectPtr());
+		const FNavMeshPolyGraph* Graph = GetPolyGraph(NavData);
+		if (!Graph || !Pair.Value->IsValidFor(*Graph))
+		{
+			// Restarted by the next query once the polygon graph is ready again
+			continue;
+		}
+
+		if (Pair.Value->Build(*Graph, Deadline))
+		{
+			UE_LOG(LogTemp, Verbose, TEXT("NavigationCacheSubsystem: Built cluster graph for %s (%d clusters, %d entrances)"),
+				*NavData->GetName(), Pair.Value->GetNumClusters(), Pair.Value->GetNumEntrances());
+		}
+	}
+}
+
+FNavQueryCoalescer* UNavigationCacheSubsystem::GetQueryCoalescer()
+{
+	check(IsInGameThread());
+
+	if (!bCoalesceQueries)
+	{
+		return nullptr;
+	}
+
+	// Same tolerance as the caches, so coalescing never merges queries the cache would keep apart
+	if (!QueryCoalescer.IsValid())
+	{
+		QueryCoalescer = MakeUnique<FNavQueryCoalescer>(CacheTolerance, MaxCoalescedQueriesPerFrame);
+	}
+	return QueryCoalescer.Get();
+}
+
+FNavPathScheduler* UNavigationCacheSubsystem::GetPathScheduler()
+{
+	check(IsInGameThread());
+
+	if (PathfindingBudgetMs <= 0.0f)
+	{
+		return nullptr;
+	}
+
+	if (!PathScheduler.IsValid())
+	{
+		PathScheduler = MakeUnique<FNavPathScheduler>();
+	}
+	return PathScheduler.Get();
+}
+
+FNavDebugOverlay* UNavigationCacheSubsystem::GetDebugOverlay()
+{
+	check(IsInGameThread());
+
+	if (!FNavDebugOverlay::IsEnabled())
+	{
+		return nullptr;
+	}
+
+	if (!DebugOverlay.IsValid())
+	{
+		UWorld* World = GetWorld();
+		DebugLineBatcher = NewObject<ULineBatchComponent>(World, TEXT("AutoDriverNavDebugLineBatcher"), RF_Transient);
+		DebugLineBatcher->bCalculateAccurateBounds = false;
+		DebugLineBatcher->RegisterComponentWithWorld(World);
+		DebugOverlay = MakeUnique<FNavDebugOverlay>();
+	}
+	return DebugOverlay.Get();
+}
+
+void UNavigationCacheSubsystem::ReleaseDebugOverlay()
+{
+	if (DebugOverlay.IsValid())
+	{
+		DebugOverlay->Reset(DebugLineBatcher);
+		DebugOverlay.Reset();
+	}
+
+	if (DebugLineBatcher)
+	{
+		DebugLineBatcher->DestroyComponent();
+		DebugLineBatcher = nullptr;
+	}
+}
+
+bool UNavigationCacheSubsystem::DrawReachablePoint(const ANavigationData* NavData, const FVector& Origin, float Radius, bool bStratified, FVector& OutLocation)
+{
+	check(IsInGameThread());
+
+	if (!NavData || Radius <= 0.0f || PointPoolSamplesPerFrame <= 0)
+	{
+		return false;
+	}
+
+	// Regions a quarter of the radius wide, so any origin in a region overlaps most of its pool's disc
+	const float RegionSize = Radius * 0.25f;
+
+	FPointPoolKey Key;
+	Key.NavData = FObjectKey(NavData);
+	Key.Region = FIntVector(
+		FMath::FloorToInt32(Origin.X / RegionSize),
+		FMath::FloorToInt32(Origin.Y / RegionSize),
+		FMath::FloorToInt32(Origin.Z / Radius));
+	Key.Radius = FMath::RoundToInt32(Radius);
+	Key.bStratified = bStratified;
+
+	TUniquePtr<FNavPointPool>* Pool = PointPools.Find(Key);
+	if (!Pool)
+	{
+		if (PointPools.Num() >= FMath::Max(1, MaxPointPools))
+		{
+			const FPointPoolKey* Oldest = nullptr;
+			uint64 OldestFrame = MAX_uint64;
+			for (const TPair<FPointPoolKey, TUniquePtr<FNavPointPool>>& Pair : PointPools)
+			{
+				if (Pair.Value->LastUsedFrame < OldestFrame)
+				{
+					OldestFrame = Pair.Value->LastUsedFrame;
+					Oldest = &Pair.Key;
+				}
+			}
+			PointPools.Remove(*Oldest);
+		}
+
+		// The first origin of a region becomes the pool centre; it is on the navmesh, a region centre may not be
+		Pool = &PointPools.Add(Key, MakeUnique<FNavPointPool>(Origin, Radius, bStratified, PointPoolCapacity));
+	}
+
+	FNavPointPool& PointPool = **Pool;
+	PointPool.LastUsedFrame = GFrameCounter;
+
+	const FNavMeshPolyGraph* Graph = GetPolyGraph(NavData);
+	int32 Island = INDEX_NONE;
+	if (Graph)
+	{
+		FNavLocation OriginLocation;
+		int32 OriginNode;
+		if (Graph->ProjectToNode(*NavData, Origin, OriginLocation, OriginNode))
+		{
+			Island = Graph->GetComponent(OriginNode);
+		}
+	}
+
+	if (PointPool.Draw(Origin, Radius, Graph, Island, OutLocation))
+	{
+		INC_DWORD_STAT(STAT_AutoDriver_NavPointPoolHits);
+		return true;
+	}
+
+	return false;
+}
+
+void UNavigationCacheSubsystem::ClearCaches()
+{
+	FReadScopeLock ReadLock(CachesLock);
+	for (const TPair<TPair<FObjectKey, FObjectKey>, FCacheInstance>& Pair : Caches)
+	{
+		Pair.Value.Cache->Clear();
+	}
+}
+
+int32 UNavigationCacheSubsystem::InvalidateInBounds(const FBox& Bounds)
+{
+	int32 NumRemoved = 0;
+	{
+		FReadScopeLock ReadLock(CachesLock);
+		for (const TPair<TPair<FObjectKey, FObjectKey>, FCacheInstance>& Pair : Caches)
+		{
+			NumRemoved += Pair.Value.Cache->InvalidateInBounds(Bounds);
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_AutoDriver_NavCacheInvalidations, NumRemoved);
+	return NumRemoved;
+}
+
+void UNavigationCacheSubsystem::GetCacheStatistics(int32& OutHits, int32& OutMisses, int32& OutEntries) const
+{
+	OutHits = 0;
+	OutMisses = 0;
+	OutEntries = 0;
+
+	FReadScopeLock ReadLock(CachesLock);
+	for (const TPair<TPair<FObjectKey, FObjectKey>, FCacheInstance>& Pair : Caches)
+	{
+		int32 Hits, Misses, Entries;
+		Pair.Value.Cache->GetCacheStats(Hits, Misses, Entries);
+		OutHits += Hits;
+		OutMisses += Misses;
+		OutEntries += Entries;
+	}
+}
+
+void UNavigationCacheSubsystem::LogCacheStatistics() const
+{
+	const UWorld* World = GetWorld();
+	// Package name distinguishes PIE instances (UEDPIE_0_, UEDPIE_1_, ...)
+	UE_LOG(LogTemp, Log, TEXT("NavigationCacheSubsystem: World %s"),
+		World ? *World->GetOutermost()->GetName() : TEXT("None"));
+
+	FReadScopeLock ReadLock(CachesLock);
+	for (const TPair<TPair<FObjectKey, FObjectKey>, FCacheInstance>& Pair : Caches)
+	{
+		int32 Hits, Misses, Entries;
+		Pair.Value.Cache->GetCacheStats(Hits, Misses, Entries);
+		UE_LOG(LogTemp, Log, TEXT("  %-48s | %6d entries | %8d hits | %8d misses | %.1f%% hit rate"),
+			*Pair.Value.Label, Entries, Hits, Misses,
+			Hits * 100.0f / FMath::Max(1, Hits + Misses));
+	}
+
+	for (const TPair<FObjectKey, TUniquePtr<FNavGoalTreeCache>>& Pair : GoalTrees)
+	{
+		const UObject* NavData = Pair.Key.ResolveObjectPtr();
+		UE_LOG(LogTemp, Log, TEXT("  %-48s | %6d goal trees | %.1f KB"),
+			NavData ? *NavData->GetName() : TEXT("None"),
+			Pair.Value->GetNumTrees(),
+			Pair.Value->GetAllocatedSize() / 1024.0f);
+	}
+
+	for (const TPair<FObjectKey, TUniquePtr<FNavClusterGraph>>& Pair : ClusterGraphs)
+	{
+		const UObject* NavData = Pair.Key.ResolveObjectPtr();
+		UE_LOG(LogTemp, Log, TEXT("  %-48s | %6d clusters | %6d entrances | %.1f KB"),
+			NavData ? *NavData->GetName() : TEXT("None"),
+			Pair.Value->GetNumClusters(),
+			Pair.Value->GetNumEntrances(),
+			Pair.Value->GetAllocatedSize() / 1024.0f);
+	}
+}
+
+void UNavigationCacheSubsystem::OnNavigationDirtied(const FBox& DirtyBounds)
+{
+	// The event is global: skip regions outside this world's navigation data (other PIE worlds, other maps)
+	if (!DirtyBounds.IsValid || !OverlapsWorldNavigation(DirtyBounds))
+	{
+		return;
+	}
+
+	// Stop serving paths through the region right away, then again once the new tiles exist
+	InvalidateInBounds(DirtyBounds);
+	PendingDirtyBounds.Add(DirtyBounds);
+
+	if (QueryCoalescer.IsValid())
+	{
+		QueryCoalescer->Reset();
+	}
+
+	for (const TPair<FPointPoolKey, TUniquePtr<FNavPointPool>>& Pair : PointPools)
+	{
+		Pair.Value->RemoveInBounds(DirtyBounds);
+	}
+
+	// Goal trees follow the graph version and are dropped once the rebuilt graph is used
+	for (const TPair<FObjectKey, TUniquePtr<FNavMeshPolyGraph>>& Pair : PolyGraphs)
+	{
+		const ANavigationData* NavData = Cast<ANavigationData>(Pair.Key.ResolveObjectPtr());
+		if (Pair.Value.IsValid() && NavData && NavData->GetBounds().Intersect(DirtyBounds))
+		{
+			Pair.Value->MarkDirty(DirtyBounds);
+		}
+	}
+
+	bAwaitingNavigationRebuild = true;
+}
+
+bool UNavigationCacheSubsystem::OverlapsWorldNavigation(const FBox& Bounds) const
+{
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (!NavSys)
+	{
+		return false;
+	}
+
+	for (const ANavigationData* NavData : NavSys->NavDataSet)
+	{
+		if (NavData && NavData->GetBounds().Intersect(Bounds))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void UNavigationCacheSubsystem::SettleDirtyNavigation()
+{
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (NavSys && (NavSys->IsNavigationBuildInProgress() || NavSys->HasDirtyAreasQueued()))
+	{
+		return;
+	}
+
+	// Nothing queued or building, yet a graph is still waiting: the dirty region caused no
+	// rebuild of its navmesh (or the finished event went to other navigation data). Refresh
+	// the recorded tiles from the navmesh as it is, so the graph does not stay stale for good.
+	for (const TPair<FObjectKey, TUniquePtr<FNavMeshPolyGraph>>& Pair : PolyGraphs)
+	{
+		if (Pair.Value.IsValid() && Pair.Value->IsStale())
+		{
+			if (const ANavigationData* NavData = Cast<ANavigationData>(Pair.Key.ResolveObjectPtr()))
+			{
+				Pair.Value->OnNavMeshRebuilt(*NavData);
+			}
+		}
+	}
+
+	if (PendingDirtyBounds.Num() > 0)
+	{
+		for (const FBox& DirtyBounds : PendingDirtyBounds)
+		{
+			InvalidateInBounds(DirtyBounds);
+		}
+		PendingDirtyBounds.Reset();
+	}
+
+	bAwaitingNavigationRebuild = false;
+}
+
+void UNavigationCacheSubsystem::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+	int32 NumRemoved = 0;
+	for (const FBox& DirtyBounds : PendingDirtyBounds)
+	{
+		NumRemoved += InvalidateInBounds(DirtyBounds);
+	}
+
+	if (PendingDirtyBounds.Num() > 0)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("NavigationCacheSubsystem: Navmesh rebuilt, invalidated %d cached paths in %d dirty regions"),
+			NumRemoved, PendingDirtyBounds.Num());
+	}
+
+	PendingDirtyBounds.Reset();
+
+	if (QueryCoalescer.IsValid())
+	{
+		QueryCoalescer->Reset();
+	}
+
+	if (DebugOverlay.IsValid())
+	{
+		DebugOverlay->InvalidateNavMeshAreas();
+	}
+
+	if (NavData)
+	{
+		if (TUniquePtr<FNavMeshPolyGraph>* Graph = PolyGraphs.Find(FObjectKey(NavData)))
+		{
+			if (Graph->IsValid())
+			{
+				(*Graph)->OnNavMeshRebuilt(*NavData);
+			}
+		}
+	}
+}
+
+FString UNavigationCacheSubsystem::GetPersistentCachePath() const
+{
+	const UWorld* World = GetWorld();
+	if (!World)
+	{
+		return FString();
+	}
+
+	// PIE instances of a map share one file
+	const FString MapPackage = UWorld::RemovePIEPrefix(World->GetOutermost()->GetName());
+	return FPaths::ProjectSavedDir() / TEXT("AutoDriver/NavCache") / FPaths::MakeValidFileName(MapPackage.Replace(TEXT("/"), TEXT("_"))) + TEXT(".navcache");
+}
+
+void UNavigationCacheSubsystem::LoadPersistentCaches()
+{
+	const FString FilePath = GetPersistentCachePath();
+	if (FilePath.IsEmpty())
+	{
+		return;
+	}
+
+	TUniquePtr<IMappedFileHandle> FileHandle(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+	if (!FileHandle)
+	{
+		return;
+	}
+
+	TUniquePtr<IMappedFileRegion> Region(FileHandle->MapRegion(0, FileHandle->GetFileSize()));
+	if (!Region)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("NavigationCacheSubsystem: Could not map %s"), *FilePath);
+		return;
+	}
+
+	FMemoryReaderView Reader(MakeArrayView(Region->GetMappedPtr(), static_cast<int32>(Region->GetMappedSize())));
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	int32 NumCaches = 0;
+	Reader << Magic << Version << NumCaches;
+	if (Magic != NavCachePersistence::FileMagic || Version != NavCachePersistence::FileVersion)
+	{
+		UE_LOG(LogTemp, Log, TEXT("NavigationCacheSubsystem: Ignoring %s (unknown format)"), *FilePath);
+		return;
+	}
+
+	// Counts come from disk: a corrupt one must not size an allocation. Entries are only
+	// cached once the whole file has parsed, so a bad file is discarded as a whole.
+	struct FLoadedEntry
+	{
+		FNavigationQueryCache* Cache;
+		FVector From;
+		FVector To;
+		FNavPathSharedPtr Path;
+		float PathLength;
+	};
+	TArray<FLoadedEntry> Loaded;
+	int32 NumSkipped = 0;
+	bool bCorrupt = !NavCachePersistence::IsCountPlausible(Reader, NumCaches, NavCachePersistence::MinCacheSize);
+
+	for (int32 CacheIndex = 0; CacheIndex < NumCaches && !bCorrupt && !Reader.IsError(); ++CacheIndex)
+	{
+		FString NavDataName;
+		FString FilterClassPath;
+		uint32 GraphHash = 0;
+		int32 NumEntries = 0;
+		Reader << NavDataName << FilterClassPath << GraphHash << NumEntries;
+		if (Reader.IsError() || !NavCachePersistence::IsCountPlausible(Reader, NumEntries, NavCachePersistence::MinEntrySize))
+		{
+			bCorrupt = true;
+			break;
+		}
+
+		const ANavigationData* NavData = nullptr;
+		for (TActorIterator<ANavigationData> It(GetWorld()); It; ++It)
+		{
+			if (It->GetName() == NavDataName)
+			{
+				NavData = *It;
+				break;
+			}
+		}
+
+		// Only trust entries computed on exactly this navmesh build
+		const FNavMeshPolyGraph* Graph = GetPolyGraph(NavData);
+		const TSubclassOf<UNavigationQueryFilter> FilterClass = FilterClassPath.IsEmpty()
+			? nullptr
+			: FSoftClassPath(FilterClassPath).ResolveClass();
+		const bool bMatches = Graph && Graph->GetDataHash() == GraphHash && (FilterClassPath.IsEmpty() || FilterClass);
+		FNavigationQueryCache* Cache = bMatches ? &GetCache(NavData, FilterClass) : nullptr;
+
+		for (int32 EntryIndex = 0; EntryIndex < NumEntries && !Reader.IsError(); ++EntryIndex)
+		{
+			FVector From;
+			FVector To;
+			bool bIsValid = false;
+			float PathLength = 0.0f;
+			int32 NumPoints = 0;
+			Reader << From << To << bIsValid << PathLength << NumPoints;
+			if (Reader.IsError() || !NavCachePersistence::IsCountPlausible(Reader, NumPoints, NavCachePersistence::PointSize))
+			{
+				bCorrupt = true;
+				break;
+			}
+
+			TArray<FVector> Points;
+			TArray<NavNodeRef> NodeRefs;
+			Points.SetNumUninitialized(NumPoints);
+			NodeRefs.SetNumUninitialized(NumPoints);
+			for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+			{
+				Reader << Points[PointIndex] << NodeRefs[PointIndex];
+			}
+
+			if (!Cache)
+			{
+				++NumSkipped;
+				continue;
+			}
+
+			FNavPathSharedPtr Path;
+			if (bIsValid && NumPoints > 1)
+			{
+				Path = MakeShared<FNavigationPath, ESPMode::ThreadSafe>(Points);
+				Path->SetNavigationDataUsed(NavData);
+				Path->MarkReady();
+
+				TArray<FNavPathPoint>& PathPoints = Path->GetPathPoints();
+				for (int32 PointIndex = 0; PointIndex < PathPoints.Num(); ++PointIndex)
+				{
+					PathPoints[PointIndex].NodeRef = NodeRefs[PointIndex];
+				}
+			}
+
+			Loaded.Add({ Cache, From, To, MoveTemp(Path), PathLength });
+		}
+	}
+
+	if (bCorrupt || Reader.IsError())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("NavigationCacheSubsystem: %s is truncated or corrupt, discarding it"), *FilePath);
+		return;
+	}
+
+	for (FLoadedEntry& Entry : Loaded)
+	{
+		Entry.Cache->CachePath(Entry.From, Entry.To, Entry.Path, Entry.PathLength);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("NavigationCacheSubsystem: Loaded %d cached paths from %s (%d skipped, navmesh changed)"),
+		Loaded.Num(), *FilePath, NumSkipped);
+}
+
+void UNavigationCacheSubsystem::SavePersistentCaches()
+{
+	const FString FilePath = GetPersistentCachePath();
+	if (FilePath.IsEmpty())
+	{
+		return;
+	}
+
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+
+	uint32 Magic = NavCachePersistence::FileMagic;
+	int32 Version = NavCachePersistence::FileVersion;
+	int32 NumCaches = 0;
+	Writer << Magic << Version;
+	const int64 NumCachesOffset = Writer.Tell();
+	Writer << NumCaches;
+
+	int32 NumSaved = 0;
+	{
+		FReadScopeLock ReadLock(CachesLock);
+		for (const TPair<TPair<FObjectKey, FObjectKey>, FCacheInstance>& Pair : Caches)
+		{
+			// Without a ready graph there is no hash to validate the entries against later
+			const TUniquePtr<FNavMeshPolyGraph>* Graph = PolyGraphs.Find(Pair.Key.Key);
+			if (!Graph || !Graph->IsValid() || !(*Graph)->IsReady())
+			{
+				continue;
+			}
+
+			FString NavDataName = Pair.Value.NavDataName;
+			FString FilterClassPath = Pair.Value.FilterClassPath;
+			uint32 GraphHash = (*Graph)->GetDataHash();
+			int32 NumEntries = 0;
+			Writer << NavDataName << FilterClassPath << GraphHash;
+			const int64 NumEntriesOffset = Writer.Tell();
+			Writer << NumEntries;
+
+			Pair.Value.Cache->ForEachEntry([&Writer, &NumEntries](const FNavigationQueryCache::FCacheEntry& Entry)
+			{
+				FVector From = Entry.StartLocation;
+				FVector To = Entry.EndLocation;
+				bool bIsValid = Entry.bIsValid;
+				float PathLength = Entry.PathLength;
+				int32 NumPoints = Entry.bIsValid ? Entry.Path->GetPathPoints().Num() : 0;
+				Writer << From << To << bIsValid << PathLength << NumPoints;
+
+				for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+				{
+					const FNavPathPoint& Point = Entry.Path->GetPathPoints()[PointIndex];
+					FVector Location = Point.Location;
+					NavNodeRef NodeRef = Point.NodeRef;
+					Writer << Location << NodeRef;
+				}
+				++NumEntries;
+			});
+
+			const int64 EndOffset = Writer.Tell();
+			Writer.Seek(NumEntriesOffset);
+			Writer << NumEntries;
+			Writer.Seek(EndOffset);
+
+			NumSaved += NumEntries;
+			++NumCaches;
+		}
+	}
+
+	Writer.Seek(NumCachesOffset);
+	Writer << NumCaches;
+
+	if (NumCaches == 0)
+	{
+		return;
+	}
+
+	// Write next to the target and move into place so concurrent runs never read a partial file
+	const FString TempPath = FilePath + FString::Printf(TEXT(".%u.tmp"), FPlatformProcess::GetCurrentProcessId());
+	if (!FFileHelper::SaveArrayToFile(Data, *TempPath) || !IFileManager::Get().Move(*FilePath, *TempPath, true, true))
+	{
+		IFileManager::Get().Delete(*TempPath);
+		UE_LOG(LogTemp, Warning, TEXT("NavigationCacheSubsystem: Could not write %s"), *FilePath);
+		return;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("NavigationCacheSubsystem: Saved %d cached paths to %s"), NumSaved, *FilePath);
+}
+
+static FAutoConsoleCommand NavCacheStatsCommand(
+	TEXT("AutoDriver.NavCache.Stats"),
+	TEXT("Log navigation cache statistics for every world, per navigation data and query filter"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		if (!GEngine)
+		{
+			return;
+		}
+
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			if (UWorld* World = Context.World())
+			{
+				if (const UNavigationCacheSubsystem* Subsystem = World->GetSubsystem<UNavigationCacheSubsystem>())
+				{
+					Subsystem->LogCacheStatistics();
+				}
+			}
+		}
+	}));
@@ -2,59 +2,561 @@
 
 #include "AutoDriver/NavigationHelper.h"
 #include "AutoDriver/NavigationCache.h"
+#include "AutoDriver/NavigationCacheSubsystem.h"
+#include "AutoDriver/NavMeshPolyGraph.h"
+#include "AutoDriver/NavGoalTree.h"
+#include "AutoDriver/NavClusterGraph.h"
+#include "AutoDriver/NavQueryCoalescer.h"
+#include "AutoDriver/NavPathScheduler.h"
+#include "AutoDriver/NavDebugOverlay.h"
 #include "AutoDriver/AutoDriverStats.h"
 #include "NavigationSystem.h"
 #include "NavigationPath.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "NavMesh/NavMeshPath.h"
+#include "NavMesh/RecastNavMesh.h"
 #include "DrawDebugHelpers.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
 #include "Engine/World.h"
 
-bool UNavigationHelper::IsLocationReachable(
-	UObject* WorldContextObject,
-	const FVector& From,
-	const FVector& To,
-	const FVector& QueryExtent)
+namespace
 {
-	SCOPE_CYCLE_COUNTER(STAT_AutoDriver_NavigationQuery);
+	/** Navigation data, filter and cache a query from some world runs against */
+	struct FNavQueryContext
+	{
+		UNavigationSystemV1* NavSys = nullptr;
+		const ANavigationData* NavData = nullptr;
+		FSharedConstNavQueryFilter QueryFilter;
+		/** Null when the world has no cache subsystem (e.g. editor worlds); queries then run uncached */
+		FNavigationQueryCache* Cache = nullptr;
+		TWeakObjectPtr<UNavigationCacheSubsystem> CacheSubsystem;
+		/** Island labels of NavData; null when unavailable (not Recast, rebuilding, off the game thread) */
+		const FNavMeshPolyGraph* PolyGraph = nullptr;
+		/** Goal trees of NavData; null unless PolyGraph is set and the query uses the default filter */
+		FNavGoalTreeCache* GoalTrees = nullptr;
+		/** Cluster graph of NavData; null unless PolyGraph is set and the query uses the default filter */
+		const FNavClusterGraph* ClusterGraph = nullptr;
+		/** Answers of the current frame; null off the game thread or when coalescing is disabled */
+		FNavQueryCoalescer* Coalescer = nullptr;
+	};
 
-	FNavigationQueryCache& Cache = GetNavigationCache();
+	/**
+	 * Resolve the navigation data (default instance unless given), query filter and
+	 * per-world cache for a query
+	 */
+	FNavQueryContext MakeQueryContext(
+		UObject* WorldContextObject,
+		const ANavigationData* NavData = nullptr,
+		TSubclassOf<UNavigationQueryFilter> FilterClass = nullptr)
+	{
+		FNavQueryContext Context;
+		Context.NavSys = UNavigationHelper::GetNavigationSystem(WorldContextObject);
+		if (!Context.NavSys)
+		{
+			return Context;
+		}
+
+		Context.NavData = NavData ? NavData : Context.NavSys->GetDefaultNavDataInstance();
+		if (!Context.NavData)
+		{
+			return Context;
+		}
 
-	// Check cache first
-	FNavigationQueryCache::FCacheEntry CachedEntry;
-	if (Cache.FindCachedPath(From, To, CachedEntry))
+		Context.QueryFilter = UNavigationQueryFilter::GetQueryFilter(*Context.NavData, FilterClass);
+
+		if (UNavigationCacheSubsystem* Subsystem = UNavigationCacheSubsystem::Get(WorldContextObject))
+		{
+			Context.Cache = &Subsystem->GetCache(Context.NavData, FilterClass);
+			Context.CacheSubsystem = Subsystem;
+
+			if (IsInGameThread())
+			{
+				Context.Coalescer = Subsystem->GetQueryCoalescer();
+				Context.PolyGraph = Subsystem->GetPolyGraph(Context.NavData);
+
+				// Trees and clusters are built for the default filter's area costs, so only default-filter queries may use them
+				if (Context.PolyGraph && !FilterClass)
+				{
+					Context.GoalTrees = Subsystem->GetGoalTrees(Context.NavData);
+					Context.ClusterGraph = Subsystem->GetClusterGraph(Context.NavData);
+				}
+			}
+		}
+
+		return Context;
+	}
+
+	/**
+	 * Build a path from the goal tree of To's polygon, string-pulled through the tree's corridor.
+	 * Counts as a request towards building that tree.
+	 * @return Path, or null when the goal has no tree (yet) or From cannot reach it through the tree
+	 */
+	FNavPathSharedPtr FindPathInGoalTree(const FNavQueryContext& Context, const FVector& From, const FVector& To)
 	{
-		INC_DWORD_STAT(STAT_AutoDriver_NavCacheHits);
-		return CachedEntry.bIsValid;
+#if WITH_RECAST
+		const ARecastNavMesh* NavMesh = Cast<const ARecastNavMesh>(Context.NavData);
+		if (!Context.GoalTrees || !NavMesh)
+		{
+			return nullptr;
+		}
+
+		FNavLocation ToLocation;
+		int32 GoalNode;
+		if (!Context.PolyGraph->ProjectToNode(*NavMesh, To, ToLocation, GoalNode))
+		{
+			return nullptr;
+		}
+
+		const FNavGoalTree* Tree = Context.GoalTrees->Find(*Context.PolyGraph, GoalNode);
+		if (!Tree)
+		{
+			return nullptr;
+		}
+
+		FNavLocation FromLocation;
+		int32 StartNode;
+		if (!Context.PolyGraph->ProjectToNode(*NavMesh, From, FromLocation, StartNode))
+		{
+			return nullptr;
+		}
+
+		TSharedRef<FNavMeshPath, ESPMode::ThreadSafe> Path = MakeShared<FNavMeshPath, ESPMode::ThreadSafe>();
+		if (!Tree->GetCorridor(*Context.PolyGraph, StartNode, Path->PathCorridor)
+			|| !NavMesh->FindStraightPath(FromLocation.Location, ToLocation.Location, Path->PathCorridor, Path->GetPathPoints()))
+		{
+			return nullptr;
+		}
+
+		Path->SetNavigationDataUsed(NavMesh);
+		Path->MarkReady();
+
+		INC_DWORD_STAT(STAT_AutoDriver_NavGoalTreeHits);
+		return Path;
+#else
+		return nullptr;
+#endif
 	}
 
-	INC_DWORD_STAT(STAT_AutoDriver_NavCacheMisses);
+	/** Open-list entry of the nearest-target search; ordered so the TArray heap pops the smallest key first */
+	struct FNearestTargetQueueItem
+	{
+		/** Cost so far plus lower bound on the rest */
+		float Key;
+		float Cost;
+		int32 Node;
+		/** Set for the final leg into a target; popping one ends the search */
+		int32 Target;
 
-	UNavigationSystemV1* NavSys = GetNavigationSystem(WorldContextObject);
-	if (!NavSys)
+		bool operator<(const FNearestTargetQueueItem& Other) const { return Key < Other.Key; }
+	};
+
+	/**
+	 * Multi-target A* over the polygon graph from Origin: polygon-centre costs, with the
+	 * straight-line distance to the closest candidate as the (consistent) heuristic.
+	 * Centre distances only rank candidates; they are no bound on real path lengths.
+	 * @param OutCandidates Indices of the targets on the origin's island
+	 * @return Index of the target with the shortest centre path, or INDEX_NONE if none is reachable
+	 */
+	int32 FindNearestTargetOnGraph(const FNavQueryContext& Context, const FVector& Origin, const TArray<FVector>& Targets, TArray<int32>& OutCandidates)
+	{
+		const FNavMeshPolyGraph& Graph = *Context.PolyGraph;
+		OutCandidates.Reset();
+
+		FNavLocation OriginLocation;
+		int32 StartNode;
+		if (!Graph.ProjectToNode(*Context.NavData, Origin, OriginLocation, StartNode))
+		{
+			return INDEX_NONE;
+		}
+
+		// Candidates on the origin's island, grouped by polygon
+		TMultiMap<int32, int32> NodeTargets;
+		TArray<FVector> TargetLocations;
+		TArray<FVector> Candidates;
+		TargetLocations.SetNum(Targets.Num());
+		for (int32 Index = 0; Index < Targets.Num(); ++Index)
+		{
+			FNavLocation TargetLocation;
+			int32 TargetNode;
+			if (Graph.ProjectToNode(*Context.NavData, Targets[Index], TargetLocation, TargetNode)
+				&& Graph.GetComponent(TargetNode) == Graph.GetComponent(StartNode))
+			{
+				NodeTargets.Add(TargetNode, Index);
+				TargetLocations[Index] = TargetLocation.Location;
+				Candidates.Add(TargetLocation.Location);
+				OutCandidates.Add(Index);
+			}
+		}
+
+		if (Candidates.Num() == 0)
+		{
+			return INDEX_NONE;
+		}
+
+		auto LowerBound = [&Candidates](const FVector& Point)
+		{
+			float Best = TNumericLimits<float>::Max();
+			for (const FVector& Candidate : Candidates)
+			{
+				Best = FMath::Min(Best, UNavigationHelper::GetStraightLineDistance(Point, Candidate));
+			}
+			return Best;
+		};
+
+		TArray<float> Costs;
+		Costs.Init(TNumericLimits<float>::Max(), Graph.GetNumNodes());
+
+		TArray<FNearestTargetQueueItem> Open;
+		Costs[StartNode] = UNavigationHelper::GetStraightLineDistance(OriginLocation.Location, Graph.GetNodeCenter(StartNode));
+		Open.HeapPush({ Costs[StartNode] + LowerBound(Graph.GetNodeCenter(StartNode)), Costs[StartNode], StartNode, INDEX_NONE });
+
+		while (Open.Num() > 0)
+		{
+			FNearestTargetQueueItem Item;
+			Open.HeapPop(Item, EAllowShrinking::No);
+
+			// Target legs carry their exact cost, so the first one popped is the best
+			if (Item.Target != INDEX_NONE)
+			{
+				return Item.Target;
+			}
+
+			if (Item.Cost > Costs[Item.Node])
+			{
+				continue;
+			}
+
+			const FVector& Center = Graph.GetNodeCenter(Item.Node);
+			for (TMultiMap<int32, int32>::TConstKeyIterator It = NodeTargets.CreateConstKeyIterator(Item.Node); It; ++It)
+			{
+				// Same polygon as the origin: straight there
+				const float Cost = Item.Node == StartNode
+					? UNavigationHelper::GetStraightLineDistance(OriginLocation.Location, TargetLocations[It.Value()])
+					: Item.Cost + UNavigationHelper::GetStraightLineDistance(Center, TargetLocations[It.Value()]);
+				Open.HeapPush({ Cost, Cost, Item.Node, It.Value() });
+			}
+
+			const TArrayView<const int32> Neighbors = Graph.GetNeighbors(Item.Node);
+			const TArrayView<const float> EdgeCosts = Graph.GetEdgeCosts(Item.Node);
+			for (int32 i = 0; i < Neighbors.Num(); ++i)
+			{
+				const int32 Next = Neighbors[i];
+				const float Cost = Item.Cost + EdgeCosts[i];
+				if (Cost < Costs[Next])
+				{
+					Costs[Next] = Cost;
+					Open.HeapPush({ Cost + LowerBound(Graph.GetNodeCenter(Next)), Cost, Next, INDEX_NONE });
+				}
+			}
+		}
+
+		return INDEX_NONE;
+	}
+
+	/** Answer a path query from the cache alone: an exact hit, or the remainder of a cached path to the same goal */
+	bool FindPathInCache(
+		const FNavQueryContext& Context,
+		const FVector& From,
+		const FVector& To,
+		FNavigationQueryCache::FCacheEntry& OutEntry)
 	{
-		Cache.CachePath(From, To, nullptr, 0.0f);
+		if (Context.Cache && Context.Cache->FindCachedPath(From, To, OutEntry))
+		{
+			INC_DWORD_STAT(STAT_AutoDriver_NavCacheHits);
+			return true;
+		}
+
+		// Re-planning partway along a cached path to the same goal: reuse its remainder
+		if (Context.Cache && Context.Cache->FindCachedSuffix(From, To, Context.QueryFilter, OutEntry))
+		{
+			INC_DWORD_STAT(STAT_AutoDriver_NavCacheSuffixHits);
+			Context.Cache->CachePath(From, To, OutEntry.Path, OutEntry.PathLength);
+			return true;
+		}
+
+		INC_DWORD_STAT(STAT_AutoDriver_NavCacheMisses);
 		return false;
 	}
 
-	// Test path existence
-	FPathFindingQuery Query;
-	Query.StartLocation = From;
-	Query.EndLocation = To;
-	Query.NavData = NavSys->GetDefaultNavDataInstance();
+	/**
+	 * Solve a path query the cache could not answer: island rejection, goal tree, then FindPathSync.
+	 * Results are only cached when the navigation data could actually be queried.
+	 */
+	FNavigationQueryCache::FCacheEntry SolvePath(
+		const FNavQueryContext& Context,
+		const FVector& From,
+		const FVector& To)
+	{
+		if (!Context.NavData)
+		{
+			return FNavigationQueryCache::FCacheEntry();
+		}
+
+		// Different islands: unreachable without running A*
+		if (Context.PolyGraph && Context.PolyGraph->AreDisconnected(*Context.NavData, From, To))
+		{
+			INC_DWORD_STAT(STAT_AutoDriver_NavIslandRejections);
+			if (Context.Cache)
+			{
+				Context.Cache->CachePath(From, To, FNavPathSharedPtr(), 0.0f);
+			}
+			return FNavigationQueryCache::FCacheEntry(From, To, FNavPathSharedPtr(), 0.0f, 0.0);
+		}
+
+		// Shared destination: follow its goal tree instead of searching
+		if (FNavPathSharedPtr TreePath = FindPathInGoalTree(Context, From, To))
+		{
+			const float PathLength = TreePath->GetLength();
+			if (Context.Cache)
+			{
+				Context.Cache->CachePath(From, To, TreePath, PathLength);
+			}
+			return FNavigationQueryCache::FCacheEntry(From, To, TreePath, PathLength, 0.0);
+		}
+
+		FPathFindingQuery Query;
+		Query.StartLocation = From;
+		Query.EndLocation = To;
+		Query.NavData = Context.NavData;
+		Query.QueryFilter = Context.QueryFilter;
+
+		FPathFindingResult Result;
+		{
+			SCOPE_CYCLE_COUNTER(STAT_AutoDriver_PathFinding);
+			Result = Context.NavSys->FindPathSync(Query);
+		}
+
+		const bool bReachable = Result.IsSuccessful() && Result.Path.IsValid();
+		const float PathLength = bReachable ? Result.Path->GetLength() : 0.0f;
 
-	if (!Query.NavData.IsValid())
+		// Cache keeps the shared path alive so later hits can reuse its geometry
+		if (Context.Cache)
+		{
+			Context.Cache->CachePath(From, To, bReachable ? Result.Path : FNavPathSharedPtr(), PathLength);
+		}
+
+		return FNavigationQueryCache::FCacheEntry(From, To, bReachable ? Result.Path : FNavPathSharedPtr(), PathLength, 0.0);
+	}
+
+	/** Answer of a matching query issued earlier in the same frame (scoped by cache, i.e. navigation data and filter) */
+	bool FindPathCoalesced(
+		const FNavQueryContext& Context,
+		const FVector& From,
+		const FVector& To,
+		FNavigationQueryCache::FCacheEntry& OutEntry)
 	{
-		Cache.CachePath(From, To, nullptr, 0.0f);
+		if (Context.Coalescer && Context.Coalescer->FindPath(Context.Cache, From, To, OutEntry))
+		{
+			INC_DWORD_STAT(STAT_AutoDriver_NavQueriesCoalesced);
+			return true;
+		}
 		return false;
 	}
 
-	FPathFindingResult Result = NavSys->FindPathSync(Query);
-	bool bReachable = Result.IsSuccessful() && Result.Path.IsValid();
+	/** Share an answer with the rest of the frame; only answers from queryable navigation data are worth it */
+	void AddPathCoalesced(const FNavQueryContext& Context, const FNavigationQueryCache::FCacheEntry& Entry)
+	{
+		if (Context.Coalescer && Context.NavData)
+		{
+			Context.Coalescer->AddPath(Context.Cache, Entry);
+		}
+	}
 
-	// Cache the result
-	float PathLength = bReachable ? Result.Path->GetLength() : 0.0f;
-	Cache.CachePath(From, To, bReachable ? Result.Path.Get() : nullptr, PathLength);
+	/**
+	 * Run a path query through the frame's earlier answers and the cache, falling back to
+	 * SolvePath on a miss
+	 */
+	FNavigationQueryCache::FCacheEntry QueryPathCached(
+		const FNavQueryContext& Context,
+		const FVector& From,
+		const FVector& To)
+	{
+		FNavigationQueryCache::FCacheEntry Entry;
+		if (FindPathCoalesced(Context, From, To, Entry))
+		{
+			return Entry;
+		}
+
+		if (!FindPathInCache(Context, From, To, Entry))
+		{
+			Entry = SolvePath(Context, From, To);
+		}
+
+		AddPathCoalesced(Context, Entry);
+		return Entry;
+	}
+
+	/**
+	 * Answer a path query on the cluster graph, without a full polygon search
+	 * @param OutLength Centre-to-centre route length plus the legs to and from the end polygons' centres
+	 * @param OutPath If given, the route is refined into a string-pulled path, and OutLength becomes its length
+	 * @return False when the cluster graph cannot answer (unavailable, endpoint off the navmesh, refinement failed)
+	 */
+	bool QueryClusterGraph(
+		const FNavQueryContext& Context,
+		const FVector& From,
+		const FVector& To,
+		bool& bOutReachable,
+		float& OutLength,
+		FNavPathSharedPtr* OutPath = nullptr)
+	{
+		bOutReachable = false;
+		OutLength = 0.0f;
+
+		if (!Context.ClusterGraph)
+		{
+			return false;
+		}
+
+		const FNavMeshPolyGraph& Graph = *Context.PolyGraph;
+
+		FNavLocation FromLocation;
+		FNavLocation ToLocation;
+		int32 StartNode;
+		int32 GoalNode;
+		if (!Graph.ProjectToNode(*Context.NavData, From, FromLocation, StartNode)
+			|| !Graph.ProjectToNode(*Context.NavData, To, ToLocation, GoalNode))
+		{
+			return false;
+		}
+
+		float Distance;
+		TArray<int32> Nodes;
+		bOutReachable = Context.ClusterGraph->FindDistance(Graph, StartNode, GoalNode, Distance, OutPath ? &Nodes : nullptr);
+
+		INC_DWORD_STAT(STAT_AutoDriver_NavClusterQueries);
+
+		if (!bOutReachable)
+		{
+			return true;
+		}
+
+		OutLength = StartNode == GoalNode
+			? UNavigationHelper::GetStraightLineDistance(FromLocation.Location, ToLocation.Location)
+			: UNavigationHelper::GetStraightLineDistance(FromLocation.Location, Graph.GetNodeCenter(StartNode))
+				+ Distance
+				+ UNavigationHelper::GetStraightLineDistance(Graph.GetNodeCenter(GoalNode), ToLocation.Location);
+
+		if (!OutPath)
+		{
+			return true;
+		}
 
-	return bReachable;
+#if WITH_RECAST
+		const ARecastNavMesh* NavMesh = Cast<const ARecastNavMesh>(Context.NavData);
+		if (!NavMesh)
+		{
+			return false;
+		}
+
+		TSharedRef<FNavMeshPath, ESPMode::ThreadSafe> Path = MakeShared<FNavMeshPath, ESPMode::ThreadSafe>();
+		Path->PathCorridor.Reserve(Nodes.Num());
+		for (const int32 Node : Nodes)
+		{
+			Path->PathCorridor.Add(Graph.GetNodeRef(Node));
+		}
+
+		if (!NavMesh->FindStraightPath(FromLocation.Location, ToLocation.Location, Path->PathCorridor, Path->GetPathPoints()))
+		{
+			return false;
+		}
+
+		Path->SetNavigationDataUsed(NavMesh);
+		Path->MarkReady();
+
+		*OutPath = Path;
+		OutLength = Path->GetLength();
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	/** Cache and share a cluster graph answer; a reachable one is only kept along with its refined path */
+	void CacheClusterAnswer(
+		const FNavQueryContext& Context,
+		const FVector& From,
+		const FVector& To,
+		bool bReachable,
+		const FNavPathSharedPtr& Path,
+		float PathLength)
+	{
+		if (bReachable && !Path.IsValid())
+		{
+			return;
+		}
+
+		if (Context.Cache)
+		{
+			Context.Cache->CachePath(From, To, Path, PathLength);
+		}
+		AddPathCoalesced(Context, FNavigationQueryCache::FCacheEntry(From, To, Path, PathLength, 0.0));
+	}
+
+	/**
+	 * Project a point onto the default navigation data, sharing the answer with identical
+	 * projections issued earlier in the same frame
+	 */
+	bool ProjectPointCoalesced(
+		UObject* WorldContextObject,
+		UNavigationSystemV1& NavSys,
+		const FVector& Location,
+		const FVector& QueryExtent,
+		FNavLocation& OutLocation)
+	{
+		UNavigationCacheSubsystem* Subsystem = IsInGameThread() ? UNavigationCacheSubsystem::Get(WorldContextObject) : nullptr;
+		FNavQueryCoalescer* Coalescer = Subsystem ? Subsystem->GetQueryCoalescer() : nullptr;
+		const ANavigationData* NavData = NavSys.GetDefaultNavDataInstance();
+
+		bool bProjected = false;
+		if (Coalescer && Coalescer->FindProjection(NavData, Location, QueryExtent, OutLocation, bProjected))
+		{
+			INC_DWORD_STAT(STAT_AutoDriver_NavQueriesCoalesced);
+			return bProjected;
+		}
+
+		bProjected = NavSys.ProjectPointToNavigation(Location, OutLocation, QueryExtent);
+
+		if (Coalescer && NavData)
+		{
+			Coalescer->AddProjection(NavData, Location, QueryExtent, OutLocation, bProjected);
+		}
+
+		return bProjected;
+	}
+}
+
+bool UNavigationHelper::IsLocationReachable(
+	UObject* WorldContextObject,
+	const FVector& From,
+	const FVector& To,
+	const FVector& QueryExtent)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AutoDriver_NavigationQuery);
+
+	const FNavQueryContext Context = MakeQueryContext(WorldContextObject);
+
+	FNavigationQueryCache::FCacheEntry Entry;
+	if (FindPathCoalesced(Context, From, To, Entry) || FindPathInCache(Context, From, To, Entry))
+	{
+		return Entry.bIsValid;
+	}
+
+	// The cluster graph answers without searching every polygon in between; the route is refined
+	// into a path so the answer is cached and shared like a solved one
+	bool bReachable;
+	float PathLength;
+	FNavPathSharedPtr Path;
+	if (QueryClusterGraph(Context, From, To, bReachable, PathLength, &Path))
+	{
+		CacheClusterAnswer(Context, From, To, bReachable, Path, PathLength);
+		return bReachable;
+	}
+
+	Entry = SolvePath(Context, From, To);
+	AddPathCoalesced(Context, Entry);
+	return Entry.bIsValid;
 }
 
 bool UNavigationHelper::IsLocationOnNavMesh(
@@ -69,7 +571,7 @@ bool UNavigationHelper::IsLocationOnNavMesh(
 	}
 
 	FNavLocation NavLocation;
-	return NavSys->ProjectPointToNavigation(Location, NavLocation, QueryExtent);
+	return ProjectPointCoalesced(WorldContextObject, *NavSys, Location, QueryExtent, NavLocation);
 }
 
 FNavigationQueryResult UNavigationHelper::ProjectLocationToNavMesh(
@@ -84,7 +586,7 @@ FNavigationQueryResult UNavigationHelper::ProjectLocationToNavMesh(
 	}
 
 	FNavLocation NavLocation;
-	if (NavSys->ProjectPointToNavigation(Location, NavLocation, QueryExtent))
+	if (ProjectPointCoalesced(WorldContextObject, *NavSys, Location, QueryExtent, NavLocation))
 	{
 		return FNavigationQueryResult::Success(NavLocation.Location);
 	}
@@ -92,6 +594,87 @@ FNavigationQueryResult UNavigationHelper::ProjectLocationToNavMesh(
 	return FNavigationQueryResult::Failure(TEXT("Could not project location to navmesh"));
 }
 
+int32 UNavigationHelper::ProjectLocationsToNavMesh(
+	UObject* WorldContextObject,
+	const TArray<FVector>& Locations,
+	TArray<FVector>& OutLocations,
+	TArray<bool>& OutProjected,
+	const FVector& QueryExtent)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AutoDriver_NavigationQuery);
+
+	OutLocations = Locations;
+	OutProjected.Init(false, Locations.Num());
+
+	UNavigationSystemV1* NavSys = GetNavigationSystem(WorldContextObject);
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance() : nullptr;
+	if (!NavData || Locations.Num() == 0)
+	{
+		return 0;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Sort by tile so every chunk stays within a few tiles and their data stays hot
+	float TileSize = 1000.0f;
+#if WITH_RECAST
+	if (const ARecastNavMesh* NavMesh = Cast<const ARecastNavMesh>(NavData))
+	{
+		TileSize = FMath::Max(NavMesh->GetTileSizeUU(), 1.0f);
+	}
+#endif
+
+	TArray<TPair<uint64, int32>> Order;
+	Order.Reserve(Locations.Num());
+	for (int32 Index = 0; Index < Locations.Num(); ++Index)
+	{
+		const uint32 TileX = static_cast<uint32>(FMath::FloorToInt32(Locations[Index].X / TileSize));
+		const uint32 TileY = static_cast<uint32>(FMath::FloorToInt32(Locations[Index].Y / TileSize));
+		Order.Emplace((static_cast<uint64>(TileY) << 32) | TileX, Index);
+	}
+	Order.Sort([](const TPair<uint64, int32>& A, const TPair<uint64, int32>& B) { return A.Key < B.Key; });
+
+	const FSharedConstNavQueryFilter QueryFilter = NavData->GetDefaultQueryFilter();
+	const int32 ChunkSize = 256;
+	const int32 NumChunks = FMath::DivideAndRoundUp(Order.Num(), ChunkSize);
+
+	// Navmesh queries only read tile data; off the game thread each call sets up its own query object
+	std::atomic<int32> NumProjected{ 0 };
+	ParallelFor(NumChunks, [&](int32 Chunk)
+	{
+		const int32 First = Chunk * ChunkSize;
+		const int32 Count = FMath::Min(ChunkSize, Order.Num() - First);
+
+		TArray<FNavigationProjectionWork> Work;
+		Work.Reserve(Count);
+		for (int32 i = 0; i < Count; ++i)
+		{
+			Work.Emplace(Locations[Order[First + i].Value]);
+		}
+
+		NavData->BatchProjectPoints(Work, QueryExtent, QueryFilter);
+
+		int32 ChunkProjected = 0;
+		for (int32 i = 0; i < Count; ++i)
+		{
+			if (Work[i].bResult)
+			{
+				const int32 Index = Order[First + i].Value;
+				OutLocations[Index] = Work[i].OutLocation.Location;
+				OutProjected[Index] = true;
+				++ChunkProjected;
+			}
+		}
+		NumProjected.fetch_add(ChunkProjected, std::memory_order_relaxed);
+	});
+
+	const double Seconds = FPlatformTime::Seconds() - StartTime;
+	UE_LOG(LogTemp, Verbose, TEXT("NavigationHelper: Projected %d/%d locations in %.2f ms (%.2f M points/s)"),
+		NumProjected.load(), Locations.Num(), Seconds * 1000.0, Locations.Num() / FMath::Max(Seconds, SMALL_NUMBER) / 1.0e6);
+
+	return NumProjected.load();
+}
+
 FNavigationQueryResult UNavigationHelper::GetPathLength(
 	UObject* WorldContextObject,
 	const FVector& From,
@@ -99,53 +682,400 @@ FNavigationQueryResult UNavigationHelper::GetPathLength(
 {
 	SCOPE_CYCLE_COUNTER(STAT_AutoDriver_NavigationQuery);
 
-	FNavigationQueryCache& Cache = GetNavigationCache();
+	const FNavQueryContext Context = MakeQueryContext(WorldContextObject);
+	FNavigationQueryCache::FCacheEntry Entry = QueryPathCached(Context, From, To);
 
-	// Check cache first
-	FNavigationQueryCache::FCacheEntry CachedEntry;
-	if (Cache.FindCachedPath(From, To, CachedEntry))
+	if (Entry.bIsValid)
 	{
-		INC_DWORD_STAT(STAT_AutoDriver_NavCacheHits);
-		if (CachedEntry.bIsValid)
+		return FNavigationQueryResult::Success(To, Entry.PathLength);
+	}
+
+	if (!Context.NavSys)
+	{
+		return FNavigationQueryResult::Failure(TEXT("Navigation system not available"));
+	}
+
+	return FNavigationQueryResult::Failure(TEXT("Path not found"));
+}
+
+FNavigationQueryResult UNavigationHelper::EstimatePathLength(
+	UObject* WorldContextObject,
+	const FVector& From,
+	const FVector& To,
+	bool bRefine)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AutoDriver_NavigationQuery);
+
+	const FNavQueryContext Context = MakeQueryContext(WorldContextObject);
+	if (!Context.NavData)
+	{
+		return FNavigationQueryResult::Failure(TEXT("Navigation system not available"));
+	}
+
+	// Known paths give the exact length for free
+	FNavigationQueryCache::FCacheEntry Entry;
+	if (FindPathCoalesced(Context, From, To, Entry) || FindPathInCache(Context, From, To, Entry))
+	{
+		return Entry.bIsValid
+			? FNavigationQueryResult::Success(To, Entry.PathLength)
+			: FNavigationQueryResult::Failure(TEXT("Path not found"));
+	}
+
+	bool bReachable;
+	float PathLength;
+	FNavPathSharedPtr Path;
+	if (QueryClusterGraph(Context, From, To, bReachable, PathLength, bRefine ? &Path : nullptr))
+	{
+		// A refined path is as good as a solved one, so keep it
+		CacheClusterAnswer(Context, From, To, bReachable, Path, PathLength);
+
+		return bReachable
+			? FNavigationQueryResult::Success(To, PathLength)
+			: FNavigationQueryResult::Failure(TEXT("Path not found"));
+	}
+
+	Entry = SolvePath(Context, From, To);
+	AddPathCoalesced(Context, Entry);
+
+	return Entry.bIsValid
+		? FNavigationQueryResult::Success(To, Entry.PathLength)
+		: FNavigationQueryResult::Failure(TEXT("Path not found"));
+}
+
+FNavigationQueryResult UNavigationHelper::FindNearestByPathLength(
+	UObject* WorldContextObject,
+	const FVector& Origin,
+	const TArray<FVector>& Targets,
+	int32& OutTargetIndex)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AutoDriver_NavigationQuery);
+
+	OutTargetIndex = INDEX_NONE;
+
+	const FNavQueryContext Context = MakeQueryContext(WorldContextObject);
+	if (!Context.NavData)
+	{
+		return FNavigationQueryResult::Failure(TEXT("Navigation system not available"));
+	}
+
+	// Candidates worth a real path query, and the one the graph ranks first
+	TArray<int32> Order;
+	int32 GraphNearest = INDEX_NONE;
+	if (Context.PolyGraph)
+	{
+		GraphNearest = FindNearestTargetOnGraph(Context, Origin, Targets, Order);
+		if (GraphNearest == INDEX_NONE)
 		{
-			return FNavigationQueryResult::Success(To, CachedEntry.PathLength);
+			return FNavigationQueryResult::Failure(TEXT("No reachable target"));
 		}
-		else
+	}
+	else
+	{
+		Order.Reserve(Targets.Num());
+		for (int32 Index = 0; Index < Targets.Num(); ++Index)
 		{
-			return FNavigationQueryResult::Failure(TEXT("Path not found (cached)"));
+			Order.Add(Index);
 		}
 	}
 
-	INC_DWORD_STAT(STAT_AutoDriver_NavCacheMisses);
+	float BestLength = TNumericLimits<float>::Max();
+	auto QueryTarget = [&Context, &Origin, &Targets, &BestLength, &OutTargetIndex](int32 Index)
+	{
+		const FNavigationQueryCache::FCacheEntry Entry = QueryPathCached(Context, Origin, Targets[Index]);
+		if (Entry.bIsValid && Entry.PathLength < BestLength)
+		{
+			BestLength = Entry.PathLength;
+			OutTargetIndex = Index;
+		}
+	};
 
-	UNavigationSystemV1* NavSys = GetNavigationSystem(WorldContextObject);
-	if (!NavSys)
+	// The graph's pick is usually the winner, so its real length rules out most other candidates
+	if (GraphNearest != INDEX_NONE)
 	{
-		Cache.CachePath(From, To, nullptr, 0.0f);
-		return FNavigationQueryResult::Failure(TEXT("Navigation system not available"));
+		QueryTarget(GraphNearest);
 	}
 
-	FPathFindingQuery Query;
-	Query.StartLocation = From;
-	Query.EndLocation = To;
-	Query.NavData = NavSys->GetDefaultNavDataInstance();
+	// A path is never shorter than the straight line: in straight-line order, stop once the next
+	// candidate's distance reaches the best real length, so the result is exact
+	Order.Sort([&Targets, &Origin](int32 A, int32 B)
+	{
+		return GetStraightLineDistance(Origin, Targets[A]) < GetStraightLineDistance(Origin, Targets[B]);
+	});
 
-	if (!Query.NavData.IsValid())
+	for (const int32 Index : Order)
 	{
-		Cache.CachePath(From, To, nullptr, 0.0f);
-		return FNavigationQueryResult::Failure(TEXT("No navigation data"));
+		if (GetStraightLineDistance(Origin, Targets[Index]) >= BestLength)
+		{
+			break;
+		}
+
+		if (Index != GraphNearest)
+		{
+			QueryTarget(Index);
+		}
 	}
 
-	FPathFindingResult Result = NavSys->FindPathSync(Query);
-	if (Result.IsSuccessful() && Result.Path.IsValid())
+	if (OutTargetIndex == INDEX_NONE)
 	{
-		float PathLength = Result.Path->GetLength();
-		Cache.CachePath(From, To, Result.Path.Get(), PathLength);
-		return FNavigationQueryResult::Success(To, PathLength);
+		return FNavigationQueryResult::Failure(TEXT("No reachable target"));
 	}
 
-	Cache.CachePath(From, To, nullptr, 0.0f);
-	return FNavigationQueryResult::Failure(TEXT("Path not found"));
+	return FNavigationQueryResult::Success(Targets[OutTargetIndex], BestLength);
+}
+
+FNavPathSharedPtr UNavigationHelper::FindPath(
+	UObject* WorldContextObject,
+	const FVector& From,
+	const FVector& To,
+	const ANavigationData* NavData,
+	TSubclassOf<UNavigationQueryFilter> FilterClass)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AutoDriver_NavigationQuery);
+
+	FNavigationQueryCache::FCacheEntry Entry = QueryPathCached(MakeQueryContext(WorldContextObject, NavData, FilterClass), From, To);
+
+	return Entry.bIsValid ? Entry.Path : FNavPathSharedPtr();
+}
+
+int32 UNavigationHelper::FindPathsAsync(
+	UObject* WorldContextObject,
+	const TArray<FVector>& Starts,
+	const TArray<FVector>& Goals,
+	FOnNavigationBatchComplete OnComplete)
+{
+	return FindPathsAsync(WorldContextObject, Starts, Goals,
+		[OnComplete](const TArray<FNavigationQueryResult>& Results)
+		{
+			OnComplete.ExecuteIfBound(Results);
+		});
+}
+
+int32 UNavigationHelper::FindPathsAsync(
+	UObject* WorldContextObject,
+	const TArray<FVector>& Starts,
+	const TArray<FVector>& Goals,
+	TFunction<void(const TArray<FNavigationQueryResult>&)> OnComplete)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AutoDriver_NavigationQuery);
+
+	/** Shared by all outstanding queries of one batch */
+	struct FPathBatch
+	{
+		TArray<FNavigationQueryResult> Results;
+		TArray<FVector> Goals;
+		/** Result indices answered by each unique query */
+		TArray<TArray<int32, TInlineAllocator<1>>> Waiters;
+		int32 PendingQueries = 0;
+		TFunction<void(const TArray<FNavigationQueryResult>&)> OnComplete;
+	};
+
+	if (Starts.Num() != Goals.Num())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("NavigationHelper: FindPathsAsync called with %d starts and %d goals"), Starts.Num(), Goals.Num());
+		OnComplete(TArray<FNavigationQueryResult>());
+		return 0;
+	}
+
+	TSharedRef<FPathBatch> Batch = MakeShared<FPathBatch>();
+	Batch->Results.SetNum(Starts.Num());
+	Batch->Goals = Goals;
+	Batch->OnComplete = MoveTemp(OnComplete);
+
+	const FNavQueryContext Context = MakeQueryContext(WorldContextObject);
+	FNavigationQueryCache* Cache = Context.Cache;
+
+	// Answer from the cache where possible, coalesce the rest by cache key
+	TArray<int32> UniqueQueries;
+	TMap<FNavigationQueryCache::FCacheKey, int32> KeyToUnique;
+
+	for (int32 i = 0; i < Starts.Num(); ++i)
+	{
+		FNavigationQueryCache::FCacheEntry Entry;
+		if (Context.Coalescer && Context.Coalescer->FindPath(Cache, Starts[i], Goals[i], Entry))
+		{
+			INC_DWORD_STAT(STAT_AutoDriver_NavQueriesCoalesced);
+			Batch->Results[i] = Entry.bIsValid
+				? FNavigationQueryResult::Success(Goals[i], Entry.PathLength)
+				: FNavigationQueryResult::Failure(TEXT("Path not found"));
+			continue;
+		}
+
+		if (Cache && Cache->FindCachedPath(Starts[i], Goals[i], Entry))
+		{
+			INC_DWORD_STAT(STAT_AutoDriver_NavCacheHits);
+			Batch->Results[i] = Entry.bIsValid
+				? FNavigationQueryResult::Success(Goals[i], Entry.PathLength)
+				: FNavigationQueryResult::Failure(TEXT("Path not found"));
+			continue;
+		}
+
+		if (Cache && Cache->FindCachedSuffix(Starts[i], Goals[i], Context.QueryFilter, Entry))
+		{
+			INC_DWORD_STAT(STAT_AutoDriver_NavCacheSuffixHits);
+			Cache->CachePath(Starts[i], Goals[i], Entry.Path, Entry.PathLength);
+			Batch->Results[i] = FNavigationQueryResult::Success(Goals[i], Entry.PathLength);
+			continue;
+		}
+
+		INC_DWORD_STAT(STAT_AutoDriver_NavCacheMisses);
+
+		if (!Context.NavData)
+		{
+			Batch->Results[i] = FNavigationQueryResult::Failure(TEXT("Navigation system not available"));
+			continue;
+		}
+
+		if (Context.PolyGraph && Context.PolyGraph->AreDisconnected(*Context.NavData, Starts[i], Goals[i]))
+		{
+			INC_DWORD_STAT(STAT_AutoDriver_NavIslandRejections);
+			if (Cache)
+			{
+				Cache->CachePath(Starts[i], Goals[i], FNavPathSharedPtr(), 0.0f);
+			}
+			Batch->Results[i] = FNavigationQueryResult::Failure(TEXT("Path not found"));
+			continue;
+		}
+
+		if (FNavPathSharedPtr TreePath = FindPathInGoalTree(Context, Starts[i], Goals[i]))
+		{
+			const float PathLength = TreePath->GetLength();
+			if (Cache)
+			{
+				Cache->CachePath(Starts[i], Goals[i], TreePath, PathLength);
+			}
+			Batch->Results[i] = FNavigationQueryResult::Success(Goals[i], PathLength);
+			continue;
+		}
+
+		FNavigationQueryCache::FCacheKey Key;
+		if (Cache)
+		{
+			Key = Cache->GenerateCacheKey(Starts[i], Goals[i]);
+			if (const int32* UniqueIndex = KeyToUnique.Find(Key))
+			{
+				const int32 Representative = UniqueQueries[*UniqueIndex];
+				if (Cache->LocationsMatch(Starts[Representative], Starts[i]) && Cache->LocationsMatch(Goals[Representative], Goals[i]))
+				{
+					Batch->Waiters[*UniqueIndex].Add(i);
+					continue;
+				}
+			}
+		}
+
+		const int32 UniqueIndex = UniqueQueries.Add(i);
+		Batch->Waiters.AddDefaulted_GetRef().Add(i);
+		if (Cache)
+		{
+			KeyToUnique.Add(Key, UniqueIndex);
+		}
+	}
+
+	Batch->PendingQueries = UniqueQueries.Num();
+	if (Batch->PendingQueries == 0)
+	{
+		Batch->OnComplete(Batch->Results);
+		return 0;
+	}
+
+	for (int32 UniqueIndex = 0; UniqueIndex < UniqueQueries.Num(); ++UniqueIndex)
+	{
+		const int32 ResultIndex = UniqueQueries[UniqueIndex];
+		const FVector From = Starts[ResultIndex];
+		const FVector To = Goals[ResultIndex];
+
+		FPathFindingQuery Query;
+		Query.StartLocation = From;
+		Query.EndLocation = To;
+		Query.NavData = Context.NavData;
+		Query.QueryFilter = Context.QueryFilter;
+
+		// Results are dispatched on the game thread; the world (and its caches) may be gone by then
+		Context.NavSys->FindPathAsync(Context.NavData->GetConfig(), Query, FNavPathQueryDelegate::CreateLambda(
+			[Batch, UniqueIndex, From, To, CacheSubsystem = Context.CacheSubsystem, NavData = TWeakObjectPtr<const ANavigationData>(Context.NavData)]
+			(uint32 QueryId, ENavigationQueryResult::Type QueryResult, FNavPathSharedPtr Path)
+			{
+				const bool bReachable = QueryResult == ENavigationQueryResult::Success && Path.IsValid() && Path->IsValid();
+				const float PathLength = bReachable ? Path->GetLength() : 0.0f;
+
+				// Errors (e.g. invalid navdata) are not cached, only genuine "no path" answers
+				const bool bAnswered = QueryResult == ENavigationQueryResult::Success || QueryResult == ENavigationQueryResult::Fail;
+				if (bAnswered && CacheSubsystem.IsValid() && NavData.IsValid())
+				{
+					CacheSubsystem->GetCache(NavData.Get()).CachePath(From, To, bReachable ? Path : FNavPathSharedPtr(), PathLength);
+				}
+
+				for (int32 Index : Batch->Waiters[UniqueIndex])
+				{
+					Batch->Results[Index] = bReachable
+						? FNavigationQueryResult::Success(Batch->Goals[Index], PathLength)
+						: FNavigationQueryResult::Failure(TEXT("Path not found"));
+				}
+
+				if (--Batch->PendingQueries == 0)
+				{
+					Batch->OnComplete(Batch->Results);
+				}
+			}));
+	}
+
+	return UniqueQueries.Num();
+}
+
+int32 UNavigationHelper::RequestPathTimeSliced(
+	UObject* WorldContextObject,
+	const FVector& From,
+	const FVector& To,
+	int32 Priority,
+	const ANavigationData* NavData,
+	TSubclassOf<UNavigationQueryFilter> FilterClass)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AutoDriver_NavigationQuery);
+
+	if (!IsInGameThread())
+	{
+		return INDEX_NONE;
+	}
+
+	const FNavQueryContext Context = MakeQueryContext(WorldContextObject, NavData, FilterClass);
+	UNavigationCacheSubsystem* Subsystem = Context.CacheSubsystem.Get();
+	FNavPathScheduler* Scheduler = Subsystem ? Subsystem->GetPathScheduler() : nullptr;
+	if (!Scheduler || !Context.NavData)
+	{
+		return INDEX_NONE;
+	}
+
+	// The search runs on the polygon graph with the default filter's area costs; filtered and short queries are solved now
+	if (!Context.PolyGraph || FilterClass || GetStraightLineDistance(From, To) < Subsystem->GetTimeSliceMinDistance())
+	{
+		const FNavigationQueryCache::FCacheEntry Entry = QueryPathCached(Context, From, To);
+		return Scheduler->AddFinished(Entry.bIsValid ? Entry.Path : FNavPathSharedPtr());
+	}
+
+	FNavigationQueryCache::FCacheEntry Entry;
+	if (FindPathInCache(Context, From, To, Entry))
+	{
+		return Scheduler->AddFinished(Entry.bIsValid ? Entry.Path : FNavPathSharedPtr());
+	}
+
+	return Scheduler->Submit(*Context.NavData, Context.Cache, From, To, Priority);
+}
+
+ENavPathRequestStatus UNavigationHelper::PollPathRequest(UObject* WorldContextObject, int32 RequestId, FNavPathSharedPtr& OutPath)
+{
+	OutPath.Reset();
+
+	UNavigationCacheSubsystem* Subsystem = UNavigationCacheSubsystem::Get(WorldContextObject);
+	FNavPathScheduler* Scheduler = Subsystem ? Subsystem->GetPathScheduler() : nullptr;
+	return Scheduler ? Scheduler->Poll(RequestId, OutPath) : ENavPathRequestStatus::Invalid;
+}
+
+void UNavigationHelper::CancelPathRequest(UObject* WorldContextObject, int32 RequestId)
+{
+	UNavigationCacheSubsystem* Subsystem = UNavigationCacheSubsystem::Get(WorldContextObject);
+	if (FNavPathScheduler* Scheduler = Subsystem ? Subsystem->GetPathScheduler() : nullptr)
+	{
+		Scheduler->Cancel(RequestId);
+	}
 }
 
 float UNavigationHelper::GetStraightLineDistance(const FVector& From, const FVector& To)
@@ -156,7 +1086,8 @@ float UNavigationHelper::GetStraightLineDistance(const FVector& From, const FVec
 FNavigationQueryResult UNavigationHelper::GetRandomReachableLocation(
 	UObject* WorldContextObject,
 	const FVector& Origin,
-	float Radius)
+	float Radius,
+	bool bStratified)
 {
 	UNavigationSystemV1* NavSys = GetNavigationSystem(WorldContextObject);
 	if (!NavSys)
@@ -164,6 +1095,17 @@ FNavigationQueryResult UNavigationHelper::GetRandomReachableLocation(
 		return FNavigationQueryResult::Failure(TEXT("Navigation system not available"));
 	}
 
+	// Pooled point first; a miss makes sure the region's pool gets filled for the next call
+	UNavigationCacheSubsystem* Subsystem = UNavigationCacheSubsystem::Get(WorldContextObject);
+	if (Subsystem && IsInGameThread())
+	{
+		FVector PooledLocation;
+		if (Subsystem->DrawReachablePoint(NavSys->GetDefaultNavDataInstance(), Origin, Radius, bStratified, PooledLocation))
+		{
+			return FNavigationQueryResult::Success(PooledLocation);
+		}
+	}
+
 	FNavLocation NavLocation;
 	if (NavSys->GetRandomReachablePointInRadius(Origin, Radius, NavLocation))
 	{
@@ -200,34 +1142,46 @@ void UNavigationHelper::DrawDebugPath(
 	float Duration,
 	FLinearColor Color)
 {
+	// Off: no query, no drawing
+	if (!FNavDebugOverlay::IsEnabled())
+	{
+		return;
+	}
+
 	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
 	if (!World)
 	{
 		return;
 	}
 
-	UNavigationSystemV1* NavSys = GetNavigationSystem(WorldContextObject);
-	if (!NavSys)
+	const FNavQueryContext Context = MakeQueryContext(WorldContextObject);
+	if (!Context.NavSys)
 	{
 		// Draw straight line if no nav system
 		DrawDebugLine(World, From, To, Color.ToFColor(true), false, Duration, 0, 3.0f);
 		return;
 	}
 
-	FPathFindingQuery Query;
-	Query.StartLocation = From;
-	Query.EndLocation = To;
-	Query.NavData = NavSys->GetDefaultNavDataInstance();
+	if (!Context.NavData)
+	{
+		return;
+	}
+
+	// Cached geometry: redrawing a path another agent (or an earlier frame) drew is free
+	const FNavigationQueryCache::FCacheEntry Entry = QueryPathCached(Context, From, To);
+	const FNavPathSharedPtr Path = Entry.bIsValid ? Entry.Path : FNavPathSharedPtr();
 
-	if (!Query.NavData.IsValid())
+	UNavigationCacheSubsystem* Subsystem = Context.CacheSubsystem.Get();
+	if (FNavDebugOverlay* Overlay = Subsystem ? Subsystem->GetDebugOverlay() : nullptr)
 	{
+		Overlay->DrawPath(From, To, Path, Color.ToFColor(true), World->GetTimeSeconds() + Duration);
 		return;
 	}
 
-	FPathFindingResult Result = NavSys->FindPathSync(Query);
-	if (Result.IsSuccessful() && Result.Path.IsValid())
+	// No subsystem (e.g. editor worlds): draw immediately
+	if (Path.IsValid())
 	{
-		const TArray<FNavPathPoint>& PathPoints = Result.Path->GetPathPoints();
+		const TArray<FNavPathPoint>& PathPoints = Path->GetPathPoints();
 
 		// Draw path segments
 		for (int32 i = 0; i < PathPoints.Num() - 1; i++)
@@ -263,6 +1217,11 @@ void UNavigationHelper::DrawDebugNavMesh(
 	float Radius,
 	float Duration)
 {
+	if (!FNavDebugOverlay::IsEnabled())
+	{
+		return;
+	}
+
 	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
 	if (!World)
 	{
@@ -270,16 +1229,22 @@ void UNavigationHelper::DrawDebugNavMesh(
 	}
 
 	UNavigationSystemV1* NavSys = GetNavigationSystem(WorldContextObject);
-	if (!NavSys)
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance() : nullptr;
+	if (!NavData)
 	{
 		return;
 	}
 
-	// Draw a sphere to show the query area
-	DrawDebugSphere(World, Location, Radius, 32, FColor::Cyan, false, Duration, 0, 2.0f);
+	UNavigationCacheSubsystem* Subsystem = UNavigationCacheSubsystem::Get(WorldContextObject);
+	if (FNavDebugOverlay* Overlay = Subsystem ? Subsystem->GetDebugOverlay() : nullptr)
+	{
+		// Polygon outlines are captured once per area and kept until the navmesh changes
+		Overlay->DrawNavMeshArea(*NavData, Location, Radius, World->GetTimeSeconds() + Duration);
+		return;
+	}
 
-	// Note: Drawing actual navmesh polygons requires more complex geometry queries
-	// For now, we just visualize the query area
+	// No subsystem (e.g. editor worlds): only show the query area
+	DrawDebugSphere(World, Location, Radius, 32, FColor::Cyan, false, Duration, 0, 2.0f);
 }
 
 UNavigationSystemV1* UNavigationHelper::GetNavigationSystem(UObject* WorldContextObject)
@@ -298,21 +1263,31 @@ bool UNavigationHelper::IsNavigationSystemAvailable(UObject* WorldContextObject)
 	return GetNavigationSystem(WorldContextObject) != nullptr;
 }
 
-void UNavigationHelper::ClearNavigationCache()
+void UNavigationHelper::ClearNavigationCache(UObject* WorldContextObject)
 {
-	GetNavigationCache().Clear();
+	if (UNavigationCacheSubsystem* Subsystem = UNavigationCacheSubsystem::Get(WorldContextObject))
+	{
+		Subsystem->ClearCaches();
+	}
 }
 
-void UNavigationHelper::GetCacheStatistics(int32& OutHits, int32& OutMisses, int32& OutEntries)
+int32 UNavigationHelper::InvalidateNavigationCacheInBounds(UObject* WorldContextObject, const FBox& Bounds)
 {
-	GetNavigationCache().GetCacheStats(OutHits, OutMisses, OutEntries);
-
-	// Update stats counters
-	SET_DWORD_STAT(STAT_AutoDriver_NavCacheEntries, OutEntries);
+	UNavigationCacheSubsystem* Subsystem = UNavigationCacheSubsystem::Get(WorldContextObject);
+	return Subsystem ? Subsystem->InvalidateInBounds(Bounds) : 0;
 }
 
-FNavigationQueryCache& UNavigationHelper::GetNavigationCache()
+void UNavigationHelper::GetCacheStatistics(UObject* WorldContextObject, int32& OutHits, int32& OutMisses, int32& OutEntries)
 {
-	static FNavigationQueryCache Cache(128, 100.0f);
-	return Cache;
+	OutHits = 0;
+	OutMisses = 0;
+	OutEntries = 0;
+
+	if (UNavigationCacheSubsystem* Subsystem = UNavigationCacheSubsystem::Get(WorldContextObject))
+	{
+		Subsystem->GetCacheStatistics(OutHits, OutMisses, OutEntries);
+	}
+
+	// Update stats counters
+	SET_DWORD_STAT(STAT_AutoDriver_NavCacheEntries, OutEntries);
 }
@@ -1,6 +1,12 @@
 // Copyright Yes UE FSD. All Rights Reserved.
 
 #include "Examples/WaypointComponent.h"
+#include "AutoDriver/NavigationHelper.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "Async/ParallelFor.h"
+#include "Algo/Reverse.h"
+#include "HAL/PlatformTime.h"
 #include "DrawDebugHelpers.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/BillboardComponent.h"
@@ -244,3 +250,228 @@ bool UWaypointRoute::IsRouteValid() const
 
 	return true;
 }
+
+uint32 UWaypointRoute::ComputeWaypointHash() const
+{
+	uint32 Hash = GetTypeHash(Waypoints.Num());
+	for (const UWaypointComponent* Waypoint : Waypoints)
+	{
+		// Round to the nearest whole unit so float noise from re-saving does not invalidate the matrix.
+		// Truncating (FIntVector(FVector)) would flip between 99 and 100 for a waypoint placed at 100.
+		FIntVector Location(MAX_int32);
+		if (Waypoint)
+		{
+			const FVector WaypointLocation = Waypoint->GetWaypointLocation();
+			Location = FIntVector(FMath::RoundToInt(WaypointLocation.X), FMath::RoundToInt(WaypointLocation.Y), FMath::RoundToInt(WaypointLocation.Z));
+		}
+		Hash = HashCombine(Hash, GetTypeHash(Location));
+	}
+	return Hash;
+}
+
+bool UWaypointRoute::BuildPathLengthMatrix(UObject* WorldContextObject)
+{
+	if (!IsRouteValid())
+	{
+		return false;
+	}
+
+	UNavigationSystemV1* NavSys = UNavigationHelper::GetNavigationSystem(WorldContextObject);
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance() : nullptr;
+	if (!NavData || NavSys->IsNavigationBuildInProgress())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("WaypointRoute: Cannot build path length matrix for %s, navigation not ready"), *RouteName);
+		return false;
+	}
+
+	const int32 NumWaypoints = Waypoints.Num();
+	TArray<FVector> Locations;
+	Locations.Reserve(NumWaypoints);
+	for (const UWaypointComponent* Waypoint : Waypoints)
+	{
+		Locations.Add(Waypoint->GetWaypointLocation());
+	}
+
+	const FSharedConstNavQueryFilter QueryFilter = NavData->GetDefaultQueryFilter();
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Recast path queries only read the navmesh, so rows can run concurrently
+	PathLengthMatrix.SetNumUninitialized(NumWaypoints * NumWaypoints);
+	ParallelFor(NumWaypoints, [this, NavData, &QueryFilter, &Locations, NumWaypoints](int32 From)
+	{
+		for (int32 To = 0; To < NumWaypoints; ++To)
+		{
+			float& Length = PathLengthMatrix[From * NumWaypoints + To];
+			if (From == To)
+			{
+				Length = 0.0f;
+				continue;
+			}
+
+			const FPathFindingQuery Query(nullptr, *NavData, Locations[From], Locations[To], QueryFilter);
+			const FPathFindingResult Result = NavData->FindPath(NavData->GetConfig(), Query);
+			Length = Result.IsSuccessful() && Result.Path.IsValid() && !Result.IsPartial()
+				? static_cast<float>(Result.Path->GetLength())
+				: -1.0f;
+		}
+	}, EParallelForFlags::Unbalanced);
+
+	PathLengthMatrixHash = ComputeWaypointHash();
+
+	UE_LOG(LogTemp, Log, TEXT("WaypointRoute: Built %dx%d path length matrix for %s in %.1f ms"),
+		NumWaypoints, NumWaypoints, *RouteName, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	return true;
+}
+
+bool UWaypointRoute::HasValidPathLengthMatrix() const
+{
+	return Waypoints.Num() > 0
+		&& PathLengthMatrix.Num() == Waypoints.Num() * Waypoints.Num()
+		&& PathLengthMatrixHash == ComputeWaypointHash();
+}
+
+float UWaypointRoute::GetPathLengthBetween(int32 FromIndex, int32 ToIndex) const
+{
+	if (!Waypoints.IsValidIndex(FromIndex) || !Waypoints.IsValidIndex(ToIndex) || !HasValidPathLengthMatrix())
+	{
+		return -1.0f;
+	}
+
+	return PathLengthMatrix[FromIndex * Waypoints.Num() + ToIndex];
+}
+
+float UWaypointRoute::GetRoutePathLength() const
+{
+	if (!HasValidPathLengthMatrix())
+	{
+		return -1.0f;
+	}
+
+	const int32 NumWaypoints = Waypoints.Num();
+	const int32 NumLegs = bLoopRoute && NumWaypoints > 1 ? NumWaypoints : NumWaypoints - 1;
+
+	float TotalLength = 0.0f;
+	for (int32 i = 0; i < NumLegs; ++i)
+	{
+		const float Length = PathLengthMatrix[i * NumWaypoints + (i + 1) % NumWaypoints];
+		if (Length < 0.0f)
+		{
+			return -1.0f;
+		}
+		TotalLength += Length;
+	}
+
+	return TotalLength;
+}
+
+float UWaypointRoute::OptimizeWaypointOrder()
+{
+	if (!HasValidPathLengthMatrix())
+	{
+		return -1.0f;
+	}
+
+	const int32 NumWaypoints = Waypoints.Num();
+	if (NumWaypoints < 3)
+	{
+		return GetRoutePathLength();
+	}
+
+	// Unreachable legs get a cost no real tour can reach, so they are avoided whenever possible
+	const float UnreachableCost = 1.0e9f;
+	auto Cost = [this, NumWaypoints, UnreachableCost](int32 From, int32 To)
+	{
+		const float Length = PathLengthMatrix[From * NumWaypoints + To];
+		return Length < 0.0f ? UnreachableCost : Length;
+	};
+
+	// Nearest neighbour tour from the authored start
+	TArray<int32> Tour;
+	Tour.Reserve(NumWaypoints);
+	TBitArray<> Visited(false, NumWaypoints);
+	Tour.Add(0);
+	Visited[0] = true;
+	while (Tour.Num() < NumWaypoints)
+	{
+		const int32 Current = Tour.Last();
+		int32 Best = INDEX_NONE;
+		for (int32 Candidate = 0; Candidate < NumWaypoints; ++Candidate)
+		{
+			if (!Visited[Candidate] && (Best == INDEX_NONE || Cost(Current, Candidate) < Cost(Current, Best)))
+			{
+				Best = Candidate;
+			}
+		}
+		Tour.Add(Best);
+		Visited[Best] = true;
+	}
+
+	// 2-opt: reverse Tour[i..j] when that shortens the lap. Paths may be asymmetric (one-way
+	// links), so the reversed segment is costed with prefix sums over both directions.
+	TArray<float> Forward;
+	TArray<float> Backward;
+	Forward.SetNumUninitialized(NumWaypoints);
+	Backward.SetNumUninitialized(NumWaypoints);
+
+	auto UpdatePrefixSums = [&]()
+	{
+		Forward[0] = 0.0f;
+		Backward[0] = 0.0f;
+		for (int32 k = 1; k < NumWaypoints; ++k)
+		{
+			Forward[k] = Forward[k - 1] + Cost(Tour[k - 1], Tour[k]);
+			Backward[k] = Backward[k - 1] + Cost(Tour[k], Tour[k - 1]);
+		}
+	};
+
+	const int32 MaxPasses = 100;
+	bool bImproved = true;
+	for (int32 Pass = 0; Pass < MaxPasses && bImproved; ++Pass)
+	{
+		bImproved = false;
+		UpdatePrefixSums();
+
+		for (int32 i = 1; i < NumWaypoints - 1; ++i)
+		{
+			for (int32 j = i + 1; j < NumWaypoints; ++j)
+			{
+				const bool bHasNext = j + 1 < NumWaypoints || bLoopRoute;
+				const int32 Next = j + 1 < NumWaypoints ? Tour[j + 1] : Tour[0];
+
+				const float OldCost = Cost(Tour[i - 1], Tour[i]) + (Forward[j] - Forward[i]) + (bHasNext ? Cost(Tour[j], Next) : 0.0f);
+				const float NewCost = Cost(Tour[i - 1], Tour[j]) + (Backward[j] - Backward[i]) + (bHasNext ? Cost(Tour[i], Next) : 0.0f);
+
+				if (NewCost < OldCost - KINDA_SMALL_NUMBER)
+				{
+					Algo::Reverse(Tour.GetData() + i, j - i + 1);
+					UpdatePrefixSums();
+					bImproved = true;
+				}
+			}
+		}
+	}
+
+	// Apply the tour to the route and permute the matrix to match
+	const float OldLength = GetRoutePathLength();
+
+	TArray<UWaypointComponent*> OrderedWaypoints;
+	TArray<float> OrderedMatrix;
+	OrderedWaypoints.Reserve(NumWaypoints);
+	OrderedMatrix.SetNumUninitialized(NumWaypoints * NumWaypoints);
+	for (int32 From = 0; From < NumWaypoints; ++From)
+	{
+		OrderedWaypoints.Add(Waypoints[Tour[From]]);
+		for (int32 To = 0; To < NumWaypoints; ++To)
+		{
+			OrderedMatrix[From * NumWaypoints + To] = PathLengthMatrix[Tour[From] * NumWaypoints + Tour[To]];
+		}
+	}
+
+	Waypoints = MoveTemp(OrderedWaypoints);
+	PathLengthMatrix = MoveTemp(OrderedMatrix);
+	PathLengthMatrixHash = ComputeWaypointHash();
+
+	const float NewLength = GetRoutePathLength();
+	UE_LOG(LogTemp, Log, TEXT("WaypointRoute: Reordered %s, lap length %.0f -> %.0f"), *RouteName, OldLength, NewLength);
+	return NewLength;
+}
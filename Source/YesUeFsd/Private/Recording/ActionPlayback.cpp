@@ -3,8 +3,8 @@
 #include "Recording/ActionPlayback.h"
 #include "AutoDriver/AutoDriverComponent.h"
 #include "AutoDriver/AutoDriverUITypes.h"
-#include "Serialization/JsonSerializer.h"
-#include "Dom/JsonObject.h"
+#include "Recording/TimelineBinaryFormat.h"
+#include "Algo/BinarySearch.h"
 
 UActionPlayback::UActionPlayback()
 {
@@ -19,7 +19,9 @@ UActionPlayback::UActionPlayback()
 	CurrentLoopCount = 0;
 	bAutoFindAutoDriver = true;
 	TimeTolerance = 0.05f;  // 50ms tolerance
+	bStreamBinaryFiles = true;
 	NextActionIndex = 0;
+	StreamChunkIndex = INDEX_NONE;
 }
 
 void UActionPlayback::BeginPlay()
@@ -31,6 +33,8 @@ void UActionPlayback::BeginPlay()
 void UActionPlayback::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Stop();
+	MappedTimeline.Reset();
+	StreamActions.Empty();
 	Super::EndPlay(EndPlayReason);
 }
 
@@ -56,7 +60,7 @@ void UActionPlayback::Play(UActionTimeline* Timeline)
 
 	// Reset playback state
 	PlaybackTime = 0.0f;
-	NextActionIndex = 0;
+	SeekActions(TNumericLimits<float>::Lowest());
 	CurrentLoopCount = 0;
 
 	SetPlaybackState(EPlaybackState::Playing);
@@ -72,7 +76,7 @@ void UActionPlayback::Stop()
 
 	SetPlaybackState(EPlaybackState::Idle);
 	PlaybackTime = 0.0f;
-	NextActionIndex = 0;
+	SeekActions(TNumericLimits<float>::Lowest());
 
 	UE_LOG(LogTemp, Log, TEXT("Stopped playback"));
 }
@@ -97,7 +101,14 @@ void UActionPlayback::Resume()
 
 void UActionPlayback::Restart()
 {
-	if (CurrentTimeline)
+	if (MappedTimeline)
+	{
+		PlaybackTime = 0.0f;
+		SeekActions(TNumericLimits<float>::Lowest());
+		CurrentLoopCount = 0;
+		SetPlaybackState(EPlaybackState::Playing);
+	}
+	else if (CurrentTimeline)
 	{
 		Play(CurrentTimeline);
 	}
@@ -105,25 +116,13 @@ void UActionPlayback::Restart()
 
 void UActionPlayback::SeekToTime(float Time)
 {
-	if (!CurrentTimeline)
+	if (!CurrentTimeline && !MappedTimeline)
 	{
 		return;
 	}
 
-	PlaybackTime = FMath::Clamp(Time, 0.0f, CurrentTimeline->GetDuration());
-
-	// Find next action to execute
-	const TArray<FRecordedAction>& Actions = CurrentTimeline->GetActions();
-	NextActionIndex = 0;
-
-	for (int32 i = 0; i < Actions.Num(); ++i)
-	{
-		if (Actions[i].Timestamp > PlaybackTime)
-		{
-			NextActionIndex = i;
-			break;
-		}
-	}
+	PlaybackTime = FMath::Clamp(Time, 0.0f, GetTimelineDuration());
+	SeekActions(PlaybackTime);
 
 	UE_LOG(LogTemp, Log, TEXT("Seeked to time: %.2f"), PlaybackTime);
 }
@@ -133,11 +132,44 @@ void UActionPlayback::SetTimeline(UActionTimeline* Timeline)
 	if (Timeline)
 	{
 		CurrentTimeline = Timeline;
+		MappedTimeline.Reset();
+		StreamActions.Empty();
+		StreamChunkIndex = INDEX_NONE;
+		PendingStreamSeek.Reset();
 	}
 }
 
+bool UActionPlayback::PlayFromFile(const FString& FilePath)
+{
+	TUniquePtr<FMappedTimeline> Timeline = FMappedTimeline::Open(FilePath);
+	if (!Timeline || Timeline->GetActionCount() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Cannot stream empty or unreadable timeline: %s"), *FilePath);
+		return false;
+	}
+
+	CurrentTimeline = nullptr;
+	MappedTimeline = MoveTemp(Timeline);
+	StreamActions.Reset();
+	StreamChunkIndex = INDEX_NONE;
+
+	PlaybackTime = 0.0f;
+	SeekActions(TNumericLimits<float>::Lowest());
+	CurrentLoopCount = 0;
+
+	SetPlaybackState(EPlaybackState::Playing);
+	UE_LOG(LogTemp, Log, TEXT("Started streamed playback of timeline: %s (%lld actions in %d chunks)"),
+		*MappedTimeline->GetMetadata().RecordingName, MappedTimeline->GetActionCount(), MappedTimeline->GetNumChunks());
+	return true;
+}
+
 bool UActionPlayback::LoadAndPlayTimeline(const FString& FilePath)
 {
+	if (bStreamBinaryFiles && TimelineBinary::IsBinaryPath(FilePath))
+	{
+		return PlayFromFile(FilePath);
+	}
+
 	UActionTimeline* Timeline = NewObject<UActionTimeline>(this);
 	if (Timeline->LoadFromFile(FilePath))
 	{
@@ -162,12 +194,22 @@ void UActionPlayback::SetPlaybackMode(EPlaybackMode Mode)
 
 float UActionPlayback::GetPlaybackProgress() const
 {
-	if (!CurrentTimeline || CurrentTimeline->GetDuration() <= 0.0f)
+	const float Duration = GetTimelineDuration();
+	if (Duration <= 0.0f)
 	{
 		return 0.0f;
 	}
 
-	return FMath::Clamp(PlaybackTime / CurrentTimeline->GetDuration(), 0.0f, 1.0f);
+	return FMath::Clamp(PlaybackTime / Duration, 0.0f, 1.0f);
+}
+
+float UActionPlayback::GetTimelineDuration() const
+{
+	if (MappedTimeline)
+	{
+		return MappedTimeline->GetDuration();
+	}
+	return CurrentTimeline ? CurrentTimeline->GetDuration() : 0.0f;
 }
 
 void UActionPlayback::SetAutoDriver(UAutoDriverComponent* AutoDriver)
@@ -189,7 +231,7 @@ void UActionPlayback::InitializeReferences()
 
 void UActionPlayback::UpdatePlayback(float DeltaTime)
 {
-	if (!CurrentTimeline || !AutoDriverComponent)
+	if ((!CurrentTimeline && !MappedTimeline) || !AutoDriverComponent)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("Cannot play: Missing timeline or AutoDriver"));
 		Stop();
@@ -203,7 +245,7 @@ void UActionPlayback::UpdatePlayback(float DeltaTime)
 	ExecutePendingActions();
 
 	// Check if playback finished
-	if (PlaybackTime >= CurrentTimeline->GetDuration())
+	if (PlaybackTime >= GetTimelineDuration())
 	{
 		HandleLoopCompletion();
 	}
@@ -211,23 +253,14 @@ void UActionPlayback::UpdatePlayback(float DeltaTime)
 
 void UActionPlayback::ExecutePendingActions()
 {
-	if (!CurrentTimeline)
-	{
-		return;
-	}
-
-	const TArray<FRecordedAction>& Actions = CurrentTimeline->GetActions();
-
 	// Execute all actions that should run at or before current time
-	while (NextActionIndex < Actions.Num())
+	while (const FRecordedAction* Action = PeekNextAction())
 	{
-		const FRecordedAction& Action = Actions[NextActionIndex];
-
 		// Check if action should be executed
-		if (Action.Timestamp <= PlaybackTime + TimeTolerance)
+		if (Action->Timestamp <= PlaybackTime + TimeTolerance)
 		{
-			ExecuteAction(Action);
-			OnActionExecuted.Broadcast(Action);
+			ExecuteAction(*Action);
+			OnActionExecuted.Broadcast(*Action);
 			NextActionIndex++;
 		}
 		else
@@ -237,144 +270,134 @@ void UActionPlayback::ExecutePendingActions()
 	}
 }
 
-void UActionPlayback::ExecuteAction(const FRecordedAction& Action)
+const FRecordedAction* UActionPlayback::PeekNextAction()
 {
-	if (Action.ActionType == TEXT("Movement"))
-	{
-		ExecuteMovementAction(Action);
-	}
-	else if (Action.ActionType == TEXT("Rotation"))
+	if (!MappedTimeline)
 	{
-		ExecuteRotationAction(Action);
-	}
-	else if (Action.ActionType == TEXT("Input"))
-	{
-		ExecuteInputAction(Action);
+		if (!CurrentTimeline)
+		{
+			return nullptr;
+		}
+
+		const TArray<FRecordedAction>& Actions = CurrentTimeline->GetActions();
+		return Actions.IsValidIndex(NextActionIndex) ? &Actions[NextActionIndex] : nullptr;
 	}
-	else if (Action.ActionType == TEXT("UIClick"))
+
+	if (PendingStreamSeek.IsSet())
 	{
-		ExecuteUIClickAction(Action);
+		const float Time = PendingStreamSeek.GetValue();
+		PendingStreamSeek.Reset();
+
+		// Binary search over the chunk index, then within the chunk
+		const int32 ChunkIndex = MappedTimeline->FindChunkAfter(Time);
+		if (ChunkIndex != StreamChunkIndex)
+		{
+			LoadStreamChunk(ChunkIndex);
+		}
+		NextActionIndex = Algo::UpperBoundBy(StreamActions, Time, &FRecordedAction::Timestamp);
 	}
-	else
+
+	// Chunks are decoded as playback reaches them; only one is held at a time
+	while (NextActionIndex >= StreamActions.Num())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Unknown action type: %s"), *Action.ActionType);
+		if (StreamChunkIndex + 1 >= MappedTimeline->GetNumChunks())
+		{
+			return nullptr;
+		}
+
+		LoadStreamChunk(StreamChunkIndex + 1);
+		NextActionIndex = 0;
 	}
+
+	return &StreamActions[NextActionIndex];
 }
 
-void UActionPlayback::ExecuteMovementAction(const FRecordedAction& Action)
+void UActionPlayback::SeekActions(float Time)
 {
-	// Parse JSON data
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Action.ActionData);
-
-	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	if (MappedTimeline)
 	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to parse movement action data"));
+		PendingStreamSeek = Time;
 		return;
 	}
 
-	// Extract movement parameters
-	FVector TargetLocation;
-	TargetLocation.X = JsonObject->GetNumberField(TEXT("X"));
-	TargetLocation.Y = JsonObject->GetNumberField(TEXT("Y"));
-	TargetLocation.Z = JsonObject->GetNumberField(TEXT("Z"));
-
-	FAutoDriverMoveParams Params;
-	Params.TargetLocation = TargetLocation;
-	Params.AcceptanceRadius = JsonObject->GetNumberField(TEXT("AcceptanceRadius"));
-	Params.SpeedMultiplier = JsonObject->GetNumberField(TEXT("SpeedMultiplier"));
-	Params.bShouldSprint = JsonObject->GetBoolField(TEXT("ShouldSprint"));
-	Params.MovementMode = static_cast<EAutoDriverMovementMode>(
-		static_cast<int32>(JsonObject->GetNumberField(TEXT("MovementMode"))));
-
-	// Execute movement command (UE 5.7: Use params struct)
-	AutoDriverComponent->MoveToLocation(Params);
-
-	UE_LOG(LogTemp, Verbose, TEXT("Executed movement to: %s"), *TargetLocation.ToString());
+	NextActionIndex = CurrentTimeline ? Algo::UpperBoundBy(CurrentTimeline->GetActions(), Time, &FRecordedAction::Timestamp) : 0;
 }
 
-void UActionPlayback::ExecuteRotationAction(const FRecordedAction& Action)
+void UActionPlayback::LoadStreamChunk(int32 ChunkIndex)
 {
-	// Parse JSON data
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Action.ActionData);
-
-	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	StreamChunkIndex = ChunkIndex;
+	if (ChunkIndex >= MappedTimeline->GetNumChunks())
 	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to parse rotation action data"));
+		StreamActions.Reset();
 		return;
 	}
 
-	// Extract rotation parameters
-	FRotator TargetRotation;
-	TargetRotation.Pitch = JsonObject->GetNumberField(TEXT("Pitch"));
-	TargetRotation.Yaw = JsonObject->GetNumberField(TEXT("Yaw"));
-	TargetRotation.Roll = JsonObject->GetNumberField(TEXT("Roll"));
-
-	FAutoDriverRotateParams Params;
-	Params.TargetRotation = TargetRotation;
-	Params.RotationSpeed = JsonObject->GetNumberField(TEXT("RotationSpeed"));
-	Params.AcceptanceAngle = JsonObject->GetNumberField(TEXT("AcceptanceAngle"));
-
-	// Execute rotation command (UE 5.7: Use params struct)
-	AutoDriverComponent->RotateToRotation(Params);
-
-	UE_LOG(LogTemp, Verbose, TEXT("Executed rotation to: %s"), *TargetRotation.ToString());
+	// Chunks decode independently, so a corrupt one only costs its own actions
+	if (!MappedTimeline->DecodeChunk(ChunkIndex, StreamActions))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Skipping corrupt chunk %d of streamed timeline"), ChunkIndex);
+	}
 }
 
-void UActionPlayback::ExecuteInputAction(const FRecordedAction& Action)
+void UActionPlayback::ExecuteAction(const FRecordedAction& Action)
 {
-	// Parse JSON data
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Action.ActionData);
-
-	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	// Timelines hold built-in actions decoded, so there is nothing to parse here
+	if (const FAutoDriverMoveParams* Move = Action.Payload.TryGet<FAutoDriverMoveParams>())
 	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to parse input action data"));
-		return;
+		ExecuteMovementAction(*Move);
 	}
-
-	// Extract input parameters
-	FString ActionName = JsonObject->GetStringField(TEXT("ActionName"));
-	float Value = JsonObject->GetNumberField(TEXT("Value"));
-	float Duration = JsonObject->GetNumberField(TEXT("Duration"));
-
-	// Execute input command
-	if (Value > 0.0f)
+	else if (const FAutoDriverRotateParams* Rotate = Action.Payload.TryGet<FAutoDriverRotateParams>())
+	{
+		ExecuteRotationAction(*Rotate);
+	}
+	else if (const FAutoDriverInputParams* Input = Action.Payload.TryGet<FAutoDriverInputParams>())
 	{
-		AutoDriverComponent->PressButton(FName(*ActionName));
+		ExecuteInputAction(*Input);
 	}
+	else if (const FUIClickParams* Click = Action.Payload.TryGet<FUIClickParams>())
+	{
+		ExecuteUIClickAction(Action.ActionName, *Click);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Unknown action type: %s"), *Action.ActionType);
+	}
+}
 
-	UE_LOG(LogTemp, Verbose, TEXT("Executed input: %s (Value: %.2f)"), *ActionName, Value);
+void UActionPlayback::ExecuteMovementAction(const FAutoDriverMoveParams& Params)
+{
+	// Execute movement command (UE 5.7: Use params struct)
+	AutoDriverComponent->MoveToLocation(Params);
+
+	UE_LOG(LogTemp, Verbose, TEXT("Executed movement to: %s"), *Params.TargetLocation.ToString());
 }
 
-void UActionPlayback::ExecuteUIClickAction(const FRecordedAction& Action)
+void UActionPlayback::ExecuteRotationAction(const FAutoDriverRotateParams& Params)
 {
-	// Parse JSON data
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Action.ActionData);
+	// Execute rotation command (UE 5.7: Use params struct)
+	AutoDriverComponent->RotateToRotation(Params);
 
-	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	UE_LOG(LogTemp, Verbose, TEXT("Executed rotation to: %s"), *Params.TargetRotation.ToString());
+}
+
+void UActionPlayback::ExecuteInputAction(const FAutoDriverInputParams& Params)
+{
+	// Execute input command
+	if (Params.Value > 0.0f)
 	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to parse UI click action data"));
-		return;
+		AutoDriverComponent->PressButton(Params.ActionName);
 	}
 
-	// Extract click parameters
-	FString ClickTypeStr = JsonObject->GetStringField(TEXT("ClickType"));
-	int32 ClickCount = JsonObject->GetIntegerField(TEXT("ClickCount"));
-
-	// Build click params
-	FUIClickParams ClickParams;
-	ClickParams.ClickCount = ClickCount;
-	ClickParams.ClickType = FUIClickParams::StringToClickType(ClickTypeStr);
+	UE_LOG(LogTemp, Verbose, TEXT("Executed input: %s (Value: %.2f)"), *Params.ActionName.ToString(), Params.Value);
+}
 
+void UActionPlayback::ExecuteUIClickAction(const FString& WidgetName, const FUIClickParams& ClickParams)
+{
 	// Execute UI click command
-	FString WidgetName = Action.ActionName;
 	AutoDriverComponent->ClickWidget(WidgetName, ClickParams);
 
 	UE_LOG(LogTemp, Verbose, TEXT("Executed UI click: %s (Type: %s, Count: %d)"),
-		*WidgetName, *ClickTypeStr, ClickCount);
+		*WidgetName, *FUIClickParams::ClickTypeToString(ClickParams.ClickType), ClickParams.ClickCount);
 }
 
 void UActionPlayback::HandleLoopCompletion()
@@ -403,7 +426,7 @@ void UActionPlayback::HandleLoopCompletion()
 	{
 		// Restart playback
 		PlaybackTime = 0.0f;
-		NextActionIndex = 0;
+		SeekActions(TNumericLimits<float>::Lowest());
 		UE_LOG(LogTemp, Log, TEXT("Loop %d completed, restarting playback"), CurrentLoopCount);
 	}
 	else
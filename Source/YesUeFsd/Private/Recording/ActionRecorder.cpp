@@ -13,7 +13,7 @@ UActionRecorder::UActionRecorder()
 	RecordingState = ERecordingState::Idle;
 	RecordingTime = 0.0f;
 	MaxRecordingDuration = 0.0f;  // Unlimited
-	RecordingBufferSize = 10000;
+	RecordingBufferSize = 0;  // Unlimited
 	bAutoStartRecording = false;
 	RecordingInterval = 0.1f;  // 10 times per second
 	bRecordMovement = true;
@@ -22,6 +22,8 @@ UActionRecorder::UActionRecorder()
 	MovementThreshold = 10.0f;  // 10 cm
 	RotationThreshold = 1.0f;   // 1 degree
 	TimeSinceLastAction = 0.0f;
+	bResumeStreamFile = false;
+	bWarnedBufferTrim = false;
 
 	LastRecordedPosition = FVector::ZeroVector;
 	LastRecordedRotation = FRotator::ZeroRotator;
@@ -52,6 +54,7 @@ void UActionRecorder::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	{
 		StopRecording();
 	}
+	CloseStream();
 
 	Super::EndPlay(EndPlayReason);
 }
@@ -95,6 +98,23 @@ void UActionRecorder::StartRecording(const FString& RecordingName)
 	// Reset recording state
 	RecordingTime = 0.0f;
 	TimeSinceLastAction = 0.0f;
+	bWarnedBufferTrim = false;
+
+	// Open the stream file; recording goes on in memory if it cannot be opened
+	CloseStream();
+	if (!StreamFilePath.IsEmpty())
+	{
+		StreamWriter = MakeUnique<FTimelineStreamWriter>();
+		if (StreamWriter->Open(StreamFilePath, Metadata, bResumeStreamFile))
+		{
+			RecordingTime = StreamWriter->GetResumeTimestamp();
+			UE_LOG(LogTemp, Log, TEXT("Streaming recording to: %s"), *StreamFilePath);
+		}
+		else
+		{
+			StreamWriter.Reset();
+		}
+	}
 
 	// Initialize position/rotation tracking
 	if (CachedPawn)
@@ -116,6 +136,7 @@ void UActionRecorder::StopRecording()
 	}
 
 	SetRecordingState(ERecordingState::Idle);
+	CloseStream();
 
 	UE_LOG(LogTemp, Log, TEXT("Stopped recording. Duration: %.2f seconds, Actions: %d"),
 		RecordingTime, CurrentTimeline ? CurrentTimeline->GetActionCount() : 0);
@@ -126,6 +147,12 @@ void UActionRecorder::PauseRecording()
 	if (RecordingState == ERecordingState::Recording)
 	{
 		SetRecordingState(ERecordingState::Paused);
+
+		// Nothing arrives while paused; get what was recorded onto disk now
+		if (StreamWriter.IsValid())
+		{
+			StreamWriter->Flush();
+		}
 		UE_LOG(LogTemp, Log, TEXT("Paused recording"));
 	}
 }
@@ -153,6 +180,12 @@ void UActionRecorder::SetTimeline(UActionTimeline* Timeline)
 	}
 }
 
+void UActionRecorder::SetStreamFile(const FString& FilePath, bool bResume)
+{
+	StreamFilePath = FilePath;
+	bResumeStreamFile = bResume;
+}
+
 bool UActionRecorder::SaveRecording(const FString& FilePath)
 {
 	if (!CurrentTimeline)
@@ -182,7 +215,7 @@ void UActionRecorder::RecordMovementAction(const FVector& TargetLocation, const
 	}
 
 	CurrentTimeline->AddMovementAction(RecordingTime, TargetLocation, Params);
-	OnActionRecorded.Broadcast(CurrentTimeline->GetActions().Last());
+	CommitAction(CurrentTimeline->GetActions().Last());
 }
 
 void UActionRecorder::RecordRotationAction(const FRotator& TargetRotation, const FAutoDriverRotateParams& Params)
@@ -193,7 +226,7 @@ void UActionRecorder::RecordRotationAction(const FRotator& TargetRotation, const
 	}
 
 	CurrentTimeline->AddRotationAction(RecordingTime, TargetRotation, Params);
-	OnActionRecorded.Broadcast(CurrentTimeline->GetActions().Last());
+	CommitAction(CurrentTimeline->GetActions().Last());
 }
 
 void UActionRecorder::RecordInputAction(const FString& ActionName, float Value, float Duration)
@@ -204,7 +237,7 @@ void UActionRecorder::RecordInputAction(const FString& ActionName, float Value,
 	}
 
 	CurrentTimeline->AddInputAction(RecordingTime, ActionName, Value, Duration);
-	OnActionRecorded.Broadcast(CurrentTimeline->GetActions().Last());
+	CommitAction(CurrentTimeline->GetActions().Last());
 }
 
 void UActionRecorder::RecordCustomAction(const FString& ActionType, const FString& ActionName, const FString& ActionData)
@@ -214,9 +247,9 @@ void UActionRecorder::RecordCustomAction(const FString& ActionType, const FStrin
 		return;
 	}
 
-	FRecordedAction Action(RecordingTime, ActionType, ActionName, ActionData);
-	CurrentTimeline->AddAction(Action);
-	OnActionRecorded.Broadcast(Action);
+	// Stream the timeline's copy: built-in types arrive as JSON and are decoded into their payload there
+	CurrentTimeline->AddAction(FRecordedAction(RecordingTime, ActionType, ActionName, ActionData));
+	CommitAction(CurrentTimeline->GetActions().Last());
 }
 
 void UActionRecorder::RecordUIClickAction(const FString& WidgetName, const FUIClickParams& ClickParams)
@@ -226,12 +259,9 @@ void UActionRecorder::RecordUIClickAction(const FString& WidgetName, const FUICl
 		return;
 	}
 
-	FString ActionData = FString::Printf(TEXT("{\"ClickType\":\"%s\",\"ClickCount\":%d}"),
-		*FUIClickParams::ClickTypeToString(ClickParams.ClickType), ClickParams.ClickCount);
-
-	FRecordedAction Action(RecordingTime, TEXT("UIClick"), WidgetName, ActionData);
+	FRecordedAction Action(RecordingTime, TEXT("UIClick"), WidgetName, FRecordedActionPayload(TInPlaceType<FUIClickParams>(), ClickParams));
 	CurrentTimeline->AddAction(Action);
-	OnActionRecorded.Broadcast(Action);
+	CommitAction(Action);
 }
 
 void UActionRecorder::InitializeReferences()
@@ -266,6 +296,12 @@ void UActionRecorder::UpdateRecording(float DeltaTime)
 	RecordingTime += DeltaTime;
 	TimeSinceLastAction += DeltaTime;
 
+	// Seal a chunk that has aged out even if no action follows it
+	if (StreamWriter.IsValid())
+	{
+		StreamWriter->Tick(RecordingTime);
+	}
+
 	// Check max duration
 	if (MaxRecordingDuration > 0.0f && RecordingTime >= MaxRecordingDuration)
 	{
@@ -337,25 +373,54 @@ void UActionRecorder::CheckRotationChanges()
 	}
 }
 
+void UActionRecorder::CommitAction(const FRecordedAction& Action)
+{
+	if (StreamWriter.IsValid())
+	{
+		StreamWriter->Add(Action);
+	}
+
+	OnActionRecorded.Broadcast(Action);
+}
+
+void UActionRecorder::CloseStream()
+{
+	if (!StreamWriter.IsValid())
+	{
+		return;
+	}
+
+	const FRecordingMetadata Metadata = CurrentTimeline ? CurrentTimeline->GetMetadata() : FRecordingMetadata();
+	StreamWriter->Close(Metadata);
+
+	UE_LOG(LogTemp, Log, TEXT("Streamed %lld actions to: %s"), StreamWriter->GetNumActions(), *StreamWriter->GetFilePath());
+	StreamWriter.Reset();
+}
+
 void UActionRecorder::EnforceBufferLimit()
 {
-	if (!CurrentTimeline)
+	if (!CurrentTimeline || RecordingBufferSize <= 0)
 	{
 		return;
 	}
 
-	// Remove oldest actions if buffer is full
-	while (CurrentTimeline->GetActionCount() > RecordingBufferSize)
+	const int32 Excess = CurrentTimeline->GetActionCount() - RecordingBufferSize;
+	if (Excess <= 0)
 	{
-		TArray<FRecordedAction> Actions = CurrentTimeline->GetActions();
-		if (Actions.Num() > 0)
-		{
-			Actions.RemoveAt(0);
-			// Note: This is inefficient - in production, ActionTimeline should have a RemoveAt method
-			// For now, we'll rely on the buffer size being reasonable
-			break;
-		}
+		return;
 	}
+
+	if (!bWarnedBufferTrim)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Recording buffer full (%d actions): dropping the oldest actions%s"),
+			RecordingBufferSize, StreamWriter ? TEXT("; the stream file keeps the whole recording") : TEXT(""));
+		bWarnedBufferTrim = true;
+	}
+
+	// Drop oldest actions with some headroom, so a full buffer shifts once every
+	// RecordingBufferSize / 16 actions rather than on every recording interval
+	const int32 Headroom = RecordingBufferSize / 16;
+	CurrentTimeline->RemoveOldestActions(Excess + Headroom);
 }
 
 void UActionRecorder::SetRecordingState(ERecordingState NewState)
@@ -1,10 +1,239 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Recording/ActionTimeline.h"
+#include "Recording/TimelineBinaryFormat.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
+#include "Serialization/CustomVersion.h"
 #include "Serialization/JsonSerializer.h"
 #include "Dom/JsonObject.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/IsSorted.h"
+
+namespace ActionPayload
+{
+	const TCHAR* const MovementType = TEXT("Movement");
+	const TCHAR* const RotationType = TEXT("Rotation");
+	const TCHAR* const InputType = TEXT("Input");
+	const TCHAR* const UIClickType = TEXT("UIClick");
+
+	/** JSON object with the fields the ActionData of each built-in type has always had */
+	TSharedPtr<FJsonObject> Encode(const FRecordedActionPayload& Payload)
+	{
+		TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+
+		if (const FAutoDriverMoveParams* Move = Payload.TryGet<FAutoDriverMoveParams>())
+		{
+			JsonObject->SetNumberField(TEXT("X"), Move->TargetLocation.X);
+			JsonObject->SetNumberField(TEXT("Y"), Move->TargetLocation.Y);
+			JsonObject->SetNumberField(TEXT("Z"), Move->TargetLocation.Z);
+			JsonObject->SetNumberField(TEXT("AcceptanceRadius"), Move->AcceptanceRadius);
+			JsonObject->SetNumberField(TEXT("SpeedMultiplier"), Move->SpeedMultiplier);
+			JsonObject->SetBoolField(TEXT("ShouldSprint"), Move->bShouldSprint);
+			JsonObject->SetNumberField(TEXT("MovementMode"), static_cast<int32>(Move->MovementMode));
+		}
+		else if (const FAutoDriverRotateParams* Rotate = Payload.TryGet<FAutoDriverRotateParams>())
+		{
+			JsonObject->SetNumberField(TEXT("Pitch"), Rotate->TargetRotation.Pitch);
+			JsonObject->SetNumberField(TEXT("Yaw"), Rotate->TargetRotation.Yaw);
+			JsonObject->SetNumberField(TEXT("Roll"), Rotate->TargetRotation.Roll);
+			JsonObject->SetNumberField(TEXT("RotationSpeed"), Rotate->RotationSpeed);
+			JsonObject->SetNumberField(TEXT("AcceptanceAngle"), Rotate->AcceptanceAngle);
+		}
+		else if (const FAutoDriverInputParams* Input = Payload.TryGet<FAutoDriverInputParams>())
+		{
+			JsonObject->SetStringField(TEXT("ActionName"), Input->ActionName.ToString());
+			JsonObject->SetNumberField(TEXT("Value"), Input->Value);
+			JsonObject->SetNumberField(TEXT("Duration"), Input->Duration);
+		}
+		else if (const FUIClickParams* Click = Payload.TryGet<FUIClickParams>())
+		{
+			JsonObject->SetStringField(TEXT("ClickType"), FUIClickParams::ClickTypeToString(Click->ClickType));
+			JsonObject->SetNumberField(TEXT("ClickCount"), Click->ClickCount);
+			JsonObject->SetNumberField(TEXT("OffsetX"), Click->OffsetFromCenter.X);
+			JsonObject->SetNumberField(TEXT("OffsetY"), Click->OffsetFromCenter.Y);
+			JsonObject->SetNumberField(TEXT("ClickDelay"), Click->ClickDelay);
+		}
+
+		return JsonObject;
+	}
+
+	/** True for the action types with a typed payload */
+	bool IsBuiltInType(const FString& ActionType)
+	{
+		return ActionType == MovementType || ActionType == RotationType || ActionType == InputType || ActionType == UIClickType;
+	}
+
+	/** Inverse of Encode for the given action type; false if the type is not built in */
+	bool Decode(const FString& ActionType, const FJsonObject& JsonObject, FRecordedActionPayload& OutPayload)
+	{
+		if (ActionType == MovementType)
+		{
+			FAutoDriverMoveParams Move;
+			int32 MovementMode = static_cast<int32>(Move.MovementMode);
+			JsonObject.TryGetNumberField(TEXT("X"), Move.TargetLocation.X);
+			JsonObject.TryGetNumberField(TEXT("Y"), Move.TargetLocation.Y);
+			JsonObject.TryGetNumberField(TEXT("Z"), Move.TargetLocation.Z);
+			JsonObject.TryGetNumberField(TEXT("AcceptanceRadius"), Move.AcceptanceRadius);
+			JsonObject.TryGetNumberField(TEXT("SpeedMultiplier"), Move.SpeedMultiplier);
+			JsonObject.TryGetBoolField(TEXT("ShouldSprint"), Move.bShouldSprint);
+			JsonObject.TryGetNumberField(TEXT("MovementMode"), MovementMode);
+			Move.MovementMode = static_cast<EAutoDriverMovementMode>(MovementMode);
+			OutPayload.Set<FAutoDriverMoveParams>(Move);
+			return true;
+		}
+
+		if (ActionType == RotationType)
+		{
+			FAutoDriverRotateParams Rotate;
+			JsonObject.TryGetNumberField(TEXT("Pitch"), Rotate.TargetRotation.Pitch);
+			JsonObject.TryGetNumberField(TEXT("Yaw"), Rotate.TargetRotation.Yaw);
+			JsonObject.TryGetNumberField(TEXT("Roll"), Rotate.TargetRotation.Roll);
+			JsonObject.TryGetNumberField(TEXT("RotationSpeed"), Rotate.RotationSpeed);
+			JsonObject.TryGetNumberField(TEXT("AcceptanceAngle"), Rotate.AcceptanceAngle);
+			OutPayload.Set<FAutoDriverRotateParams>(Rotate);
+			return true;
+		}
+
+		if (ActionType == InputType)
+		{
+			FAutoDriverInputParams Input;
+			FString ActionName;
+			JsonObject.TryGetStringField(TEXT("ActionName"), ActionName);
+			Input.ActionName = FName(*ActionName);
+			JsonObject.TryGetNumberField(TEXT("Value"), Input.Value);
+			JsonObject.TryGetNumberField(TEXT("Duration"), Input.Duration);
+			OutPayload.Set<FAutoDriverInputParams>(Input);
+			return true;
+		}
+
+		if (ActionType == UIClickType)
+		{
+			FUIClickParams Click;
+			FString ClickType;
+			if (JsonObject.TryGetStringField(TEXT("ClickType"), ClickType))
+			{
+				Click.ClickType = FUIClickParams::StringToClickType(ClickType);
+			}
+			JsonObject.TryGetNumberField(TEXT("ClickCount"), Click.ClickCount);
+			JsonObject.TryGetNumberField(TEXT("OffsetX"), Click.OffsetFromCenter.X);
+			JsonObject.TryGetNumberField(TEXT("OffsetY"), Click.OffsetFromCenter.Y);
+			JsonObject.TryGetNumberField(TEXT("ClickDelay"), Click.ClickDelay);
+			OutPayload.Set<FUIClickParams>(Click);
+			return true;
+		}
+
+		return false;
+	}
+
+	/** Field-wise equality of two payloads (the parameter structs define no operator==) */
+	bool Equals(const FRecordedActionPayload& A, const FRecordedActionPayload& B)
+	{
+		if (A.GetIndex() != B.GetIndex())
+		{
+			return false;
+		}
+
+		if (const FAutoDriverMoveParams* Move = A.TryGet<FAutoDriverMoveParams>())
+		{
+			const FAutoDriverMoveParams& Other = B.Get<FAutoDriverMoveParams>();
+			return Move->TargetLocation == Other.TargetLocation && Move->AcceptanceRadius == Other.AcceptanceRadius &&
+				Move->SpeedMultiplier == Other.SpeedMultiplier && Move->bShouldSprint == Other.bShouldSprint &&
+				Move->MovementMode == Other.MovementMode;
+		}
+		if (const FAutoDriverRotateParams* Rotate = A.TryGet<FAutoDriverRotateParams>())
+		{
+			const FAutoDriverRotateParams& Other = B.Get<FAutoDriverRotateParams>();
+			return Rotate->TargetRotation == Other.TargetRotation && Rotate->RotationSpeed == Other.RotationSpeed &&
+				Rotate->AcceptanceAngle == Other.AcceptanceAngle;
+		}
+		if (const FAutoDriverInputParams* Input = A.TryGet<FAutoDriverInputParams>())
+		{
+			const FAutoDriverInputParams& Other = B.Get<FAutoDriverInputParams>();
+			return Input->ActionName == Other.ActionName && Input->Value == Other.Value && Input->Duration == Other.Duration;
+		}
+		if (const FUIClickParams* Click = A.TryGet<FUIClickParams>())
+		{
+			const FUIClickParams& Other = B.Get<FUIClickParams>();
+			return Click->ClickType == Other.ClickType && Click->ClickCount == Other.ClickCount &&
+				Click->OffsetFromCenter == Other.OffsetFromCenter && Click->ClickDelay == Other.ClickDelay;
+		}
+		return true;
+	}
+
+	/** Serialize the parameters of one payload type, switching the payload to it when loading */
+	template <typename ParamsType>
+	void SerializeParams(FArchive& Ar, FRecordedActionPayload& Payload)
+	{
+		if (Ar.IsLoading())
+		{
+			Payload.Emplace<ParamsType>();
+		}
+		ParamsType::StaticStruct()->SerializeItem(Ar, &Payload.Get<ParamsType>(), nullptr);
+	}
+}
+
+namespace RecordedActionVersion
+{
+	enum Type : int32
+	{
+		/** Reflected properties only */
+		Initial = 0,
+		/** Payload follows the properties */
+		PayloadSerialized,
+
+		VersionPlusOne,
+		Latest = VersionPlusOne - 1
+	};
+
+	const FGuid Guid(0x6A1D3C57, 0x2F4B4E1A, 0x9C8E51B7, 0xD04A6F32);
+	FCustomVersionRegistration Registration(Guid, Latest, TEXT("RecordedAction"));
+}
+
+bool FRecordedAction::Serialize(FArchive& Ar)
+{
+	Ar.UsingCustomVersion(RecordedActionVersion::Guid);
+
+	UScriptStruct* Struct = StaticStruct();
+	Struct->SerializeTaggedProperties(Ar, reinterpret_cast<uint8*>(this), Struct, nullptr);
+
+	if (Ar.IsLoading() && Ar.CustomVer(RecordedActionVersion::Guid) < RecordedActionVersion::PayloadSerialized)
+	{
+		Payload.Emplace<FEmptyVariantState>();
+		return true;
+	}
+
+	uint8 PayloadIndex = static_cast<uint8>(Payload.GetIndex());
+	Ar << PayloadIndex;
+
+	switch (PayloadIndex)
+	{
+	case FRecordedActionPayload::IndexOfType<FEmptyVariantState>():
+		if (Ar.IsLoading())
+		{
+			Payload.Emplace<FEmptyVariantState>();
+		}
+		break;
+	case FRecordedActionPayload::IndexOfType<FAutoDriverMoveParams>():
+		ActionPayload::SerializeParams<FAutoDriverMoveParams>(Ar, Payload);
+		break;
+	case FRecordedActionPayload::IndexOfType<FAutoDriverRotateParams>():
+		ActionPayload::SerializeParams<FAutoDriverRotateParams>(Ar, Payload);
+		break;
+	case FRecordedActionPayload::IndexOfType<FAutoDriverInputParams>():
+		ActionPayload::SerializeParams<FAutoDriverInputParams>(Ar, Payload);
+		break;
+	case FRecordedActionPayload::IndexOfType<FUIClickParams>():
+		ActionPayload::SerializeParams<FUIClickParams>(Ar, Payload);
+		break;
+	default:
+		Payload.Emplace<FEmptyVariantState>();
+		Ar.SetError();
+		break;
+	}
+
+	return true;
+}
 
 UActionTimeline::UActionTimeline()
 {
@@ -14,73 +243,116 @@ UActionTimeline::UActionTimeline()
 
 void UActionTimeline::AddAction(const FRecordedAction& Action)
 {
-	Actions.Add(Action);
-	SortActions();
+	FRecordedAction NewAction = Action;
+
+	// Actions built from JSON (Blueprint, scripts) get their typed payload once, here
+	if (NewAction.Payload.IsType<FEmptyVariantState>() && !NewAction.ActionData.IsEmpty())
+	{
+		DecodeActionData(NewAction);
+	}
+
+	InsertAction(MoveTemp(NewAction));
+}
+
+void UActionTimeline::InsertAction(FRecordedAction&& Action)
+{
+	// Recorders append in time order: keep that O(1)
+	if (Actions.Num() == 0 || Action.Timestamp >= Actions.Last().Timestamp)
+	{
+		Actions.Add(MoveTemp(Action));
+	}
+	else
+	{
+		// Out of order: insert after any actions with the same timestamp, keeping insertion order among them
+		const int32 Index = Algo::UpperBoundBy(Actions, Action.Timestamp, &FRecordedAction::Timestamp);
+		Actions.Insert(MoveTemp(Action), Index);
+	}
+
 	UpdateMetadata();
 }
 
-void UActionTimeline::AddMovementAction(float Timestamp, const FVector& TargetLocation, const FAutoDriverMoveParams& Params)
+FString UActionTimeline::GetActionDataJSON(const FRecordedAction& Action)
 {
-	// Serialize movement params to JSON
-	TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
-	JsonObject->SetNumberField(TEXT("X"), TargetLocation.X);
-	JsonObject->SetNumberField(TEXT("Y"), TargetLocation.Y);
-	JsonObject->SetNumberField(TEXT("Z"), TargetLocation.Z);
-	JsonObject->SetNumberField(TEXT("AcceptanceRadius"), Params.AcceptanceRadius);
-	JsonObject->SetNumberField(TEXT("SpeedMultiplier"), Params.SpeedMultiplier);
-	JsonObject->SetBoolField(TEXT("ShouldSprint"), Params.bShouldSprint);
-	JsonObject->SetNumberField(TEXT("MovementMode"), static_cast<int32>(Params.MovementMode));
+	if (Action.Payload.IsType<FEmptyVariantState>())
+	{
+		return Action.ActionData;
+	}
 
 	FString JsonString;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
-	FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
-
-	FRecordedAction Action(Timestamp, TEXT("Movement"), TEXT("MoveToLocation"), JsonString);
-	AddAction(Action);
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonString);
+	FJsonSerializer::Serialize(ActionPayload::Encode(Action.Payload).ToSharedRef(), Writer);
+	return JsonString;
 }
 
-void UActionTimeline::AddRotationAction(float Timestamp, const FRotator& TargetRotation, const FAutoDriverRotateParams& Params)
+bool UActionTimeline::DecodeActionData(FRecordedAction& Action)
 {
-	TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
-	JsonObject->SetNumberField(TEXT("Pitch"), TargetRotation.Pitch);
-	JsonObject->SetNumberField(TEXT("Yaw"), TargetRotation.Yaw);
-	JsonObject->SetNumberField(TEXT("Roll"), TargetRotation.Roll);
-	JsonObject->SetNumberField(TEXT("RotationSpeed"), Params.RotationSpeed);
-	JsonObject->SetNumberField(TEXT("AcceptanceAngle"), Params.AcceptanceAngle);
+	if (!ActionPayload::IsBuiltInType(Action.ActionType))
+	{
+		return false;
+	}
 
-	FString JsonString;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
-	FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+	TSharedPtr<FJsonObject> JsonObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Action.ActionData);
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	{
+		return false;
+	}
 
-	FRecordedAction Action(Timestamp, TEXT("Rotation"), TEXT("RotateTo"), JsonString);
-	AddAction(Action);
+	if (!ActionPayload::Decode(Action.ActionType, *JsonObject, Action.Payload))
+	{
+		return false;
+	}
+
+	Action.ActionData.Empty();
+	return true;
 }
 
-void UActionTimeline::AddInputAction(float Timestamp, const FString& ActionName, float Value, float Duration)
+void UActionTimeline::RemoveOldestActions(int32 Count)
 {
-	TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
-	JsonObject->SetStringField(TEXT("ActionName"), ActionName);
-	JsonObject->SetNumberField(TEXT("Value"), Value);
-	JsonObject->SetNumberField(TEXT("Duration"), Duration);
+	Count = FMath::Min(Count, Actions.Num());
+	if (Count <= 0)
+	{
+		return;
+	}
 
-	FString JsonString;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
-	FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+	Actions.RemoveAt(0, Count, EAllowShrinking::No);
+	UpdateMetadata();
+}
+
+void UActionTimeline::AddMovementAction(float Timestamp, const FVector& TargetLocation, const FAutoDriverMoveParams& Params)
+{
+	FAutoDriverMoveParams Move = Params;
+	Move.TargetLocation = TargetLocation;
+	InsertAction(FRecordedAction(Timestamp, ActionPayload::MovementType, TEXT("MoveToLocation"), FRecordedActionPayload(TInPlaceType<FAutoDriverMoveParams>(), Move)));
+}
 
-	FRecordedAction Action(Timestamp, TEXT("Input"), ActionName, JsonString);
-	AddAction(Action);
+void UActionTimeline::AddRotationAction(float Timestamp, const FRotator& TargetRotation, const FAutoDriverRotateParams& Params)
+{
+	FAutoDriverRotateParams Rotate = Params;
+	Rotate.TargetRotation = TargetRotation;
+	InsertAction(FRecordedAction(Timestamp, ActionPayload::RotationType, TEXT("RotateTo"), FRecordedActionPayload(TInPlaceType<FAutoDriverRotateParams>(), Rotate)));
+}
+
+void UActionTimeline::AddInputAction(float Timestamp, const FString& ActionName, float Value, float Duration)
+{
+	FAutoDriverInputParams Input;
+	Input.ActionName = FName(*ActionName);
+	Input.Value = Value;
+	Input.Duration = Duration;
+	InsertAction(FRecordedAction(Timestamp, ActionPayload::InputType, ActionName, FRecordedActionPayload(TInPlaceType<FAutoDriverInputParams>(), Input)));
 }
 
 TArray<FRecordedAction> UActionTimeline::GetActionsInTimeRange(float StartTime, float EndTime) const
 {
 	TArray<FRecordedAction> Result;
-	for (const FRecordedAction& Action : Actions)
+	if (EndTime < StartTime)
 	{
-		if (Action.Timestamp >= StartTime && Action.Timestamp <= EndTime)
-		{
-			Result.Add(Action);
-		}
+		return Result;
 	}
+
+	const int32 First = Algo::LowerBoundBy(Actions, StartTime, &FRecordedAction::Timestamp);
+	const int32 Last = Algo::UpperBoundBy(Actions, EndTime, &FRecordedAction::Timestamp);
+	Result.Append(Actions.GetData() + First, Last - First);
 	return Result;
 }
 
@@ -111,17 +383,8 @@ void UActionTimeline::AddTag(const FString& Tag)
 
 float UActionTimeline::GetDuration() const
 {
-	if (Actions.Num() == 0)
-	{
-		return 0.0f;
-	}
-
-	float MaxTime = 0.0f;
-	for (const FRecordedAction& Action : Actions)
-	{
-		MaxTime = FMath::Max(MaxTime, Action.Timestamp);
-	}
-	return MaxTime;
+	// Actions are kept sorted, so the last one is the latest
+	return Actions.Num() > 0 ? FMath::Max(0.0f, Actions.Last().Timestamp) : 0.0f;
 }
 
 FString UActionTimeline::ExportToJSON() const
@@ -144,6 +407,16 @@ FString UActionTimeline::ExportToJSON() const
 	}
 	MetadataObject->SetArrayField(TEXT("Tags"), TagsArray);
 
+	if (Metadata.CustomData.Num() > 0)
+	{
+		TSharedPtr<FJsonObject> CustomDataObject = MakeShareable(new FJsonObject);
+		for (const TPair<FString, FString>& Pair : Metadata.CustomData)
+		{
+			CustomDataObject->SetStringField(Pair.Key, Pair.Value);
+		}
+		MetadataObject->SetObjectField(TEXT("CustomData"), CustomDataObject);
+	}
+
 	RootObject->SetObjectField(TEXT("Metadata"), MetadataObject);
 
 	// Actions
@@ -154,7 +427,17 @@ FString UActionTimeline::ExportToJSON() const
 		ActionObject->SetNumberField(TEXT("Timestamp"), Action.Timestamp);
 		ActionObject->SetStringField(TEXT("ActionType"), Action.ActionType);
 		ActionObject->SetStringField(TEXT("ActionName"), Action.ActionName);
-		ActionObject->SetStringField(TEXT("ActionData"), Action.ActionData);
+		ActionObject->SetStringField(TEXT("ActionData"), GetActionDataJSON(Action));
+
+		if (Action.Metadata.Num() > 0)
+		{
+			TSharedPtr<FJsonObject> ActionMetadataObject = MakeShareable(new FJsonObject);
+			for (const TPair<FString, FString>& Pair : Action.Metadata)
+			{
+				ActionMetadataObject->SetStringField(Pair.Key, Pair.Value);
+			}
+			ActionObject->SetObjectField(TEXT("Metadata"), ActionMetadataObject);
+		}
 
 		ActionsArray.Add(MakeShareable(new FJsonValueObject(ActionObject)));
 	}
@@ -200,6 +483,15 @@ bool UActionTimeline::ImportFromJSON(const FString& JSONString)
 				Metadata.Tags.Add(TagValue->AsString());
 			}
 		}
+
+		const TSharedPtr<FJsonObject>* CustomDataObject;
+		if (MetadataObject->TryGetObjectField(TEXT("CustomData"), CustomDataObject))
+		{
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*CustomDataObject)->Values)
+			{
+				Metadata.CustomData.Add(Pair.Key, Pair.Value->AsString());
+			}
+		}
 	}
 
 	// Parse actions
@@ -216,22 +508,113 @@ bool UActionTimeline::ImportFromJSON(const FString& JSONString)
 			Action.ActionName = ActionObject->GetStringField(TEXT("ActionName"));
 			Action.ActionData = ActionObject->GetStringField(TEXT("ActionData"));
 
-			Actions.Add(Action);
+			const TSharedPtr<FJsonObject>* ActionMetadataObject;
+			if (ActionObject->TryGetObjectField(TEXT("Metadata"), ActionMetadataObject))
+			{
+				for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*ActionMetadataObject)->Values)
+				{
+					Action.Metadata.Add(Pair.Key, Pair.Value->AsString());
+				}
+			}
+
+			// Decode once at import; playback then uses the typed payload
+			DecodeActionData(Action);
+
+			Actions.Add(MoveTemp(Action));
+		}
+	}
+
+	SortActions();
+	return true;
+}
+
+void UActionTimeline::ExportToBinary(TArray<uint8>& OutData) const
+{
+	using namespace TimelineBinary;
+
+	const FFileHeader FileHeader;
+	OutData.Reset();
+	WriteFileHeader(FileHeader, OutData);
+	WriteMetadataChunk(Metadata, OutData);
+
+	FChunkEncoder Encoder(FileHeader);
+	for (const FRecordedAction& Action : Actions)
+	{
+		Encoder.Add(Action);
+		if (Encoder.GetNumActions() >= ActionsPerBinaryChunk)
+		{
+			Encoder.Seal(OutData);
+		}
+	}
+	Encoder.Seal(OutData);
+}
+
+bool UActionTimeline::ImportFromBinary(TConstArrayView<uint8> Data)
+{
+	using namespace TimelineBinary;
+
+	FFileHeader FileHeader;
+	if (!ReadFileHeader(Data, FileHeader))
+	{
+		return false;
+	}
+
+	TArray<FChunkLocation> Chunks;
+	int64 ValidSize = 0;
+	ScanChunks(Data, Chunks, ValidSize);
+
+	FRecordingMetadata NewMetadata;
+	TArray<FRecordedAction> NewActions;
+	for (const FChunkLocation& Chunk : Chunks)
+	{
+		const TConstArrayView<uint8> Payload = Data.Slice(static_cast<int32>(Chunk.PayloadOffset), static_cast<int32>(Chunk.Header.PayloadSize));
+		const bool bRead = Chunk.Header.Type == EChunkType::Metadata
+			? ReadMetadata(Payload, NewMetadata)
+			: Chunk.Header.Type == EChunkType::Actions ? ReadActions(FileHeader, Chunk.Header, Payload, NewActions) : true;
+
+		if (!bRead)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Binary timeline: malformed chunk at offset %lld, keeping %d actions read before it"),
+				Chunk.PayloadOffset, NewActions.Num());
+			break;
 		}
 	}
 
+	if (ValidSize < Data.Num())
+	{
+		// Recorder stopped mid-write: everything up to the last complete chunk is still good
+		UE_LOG(LogTemp, Warning, TEXT("Binary timeline: ignoring %lld trailing bytes after the last complete chunk"),
+			Data.Num() - ValidSize);
+	}
+
+	Actions = MoveTemp(NewActions);
+	Metadata = MoveTemp(NewMetadata);
 	SortActions();
+	UpdateMetadata();
 	return true;
 }
 
 bool UActionTimeline::SaveToFile(const FString& FilePath)
 {
+	if (TimelineBinary::IsBinaryPath(FilePath))
+	{
+		TArray<uint8> Data;
+		ExportToBinary(Data);
+		return FFileHelper::SaveArrayToFile(Data, *FilePath);
+	}
+
 	FString JSONString = ExportToJSON();
 	return FFileHelper::SaveStringToFile(JSONString, *FilePath);
 }
 
 bool UActionTimeline::LoadFromFile(const FString& FilePath)
 {
+	if (TimelineBinary::IsBinaryPath(FilePath))
+	{
+		TArray<uint8> Data;
+		return FFileHelper::LoadFileToArray(Data, *FilePath) && ImportFromBinary(Data);
+	}
+
 	FString JSONString;
 	if (!FFileHelper::LoadFileToString(JSONString, *FilePath))
 	{
@@ -259,7 +642,8 @@ void UActionTimeline::OptimizeTimeline()
 		// Skip if it's a duplicate of the previous action
 		if (Current.ActionType == Previous.ActionType &&
 			Current.ActionName == Previous.ActionName &&
-			Current.ActionData == Previous.ActionData)
+			Current.ActionData == Previous.ActionData &&
+			ActionPayload::Equals(Current.Payload, Previous.Payload))
 		{
 			continue;
 		}
@@ -285,6 +669,7 @@ void UActionTimeline::Compress(float TimeTolerance)
 			Action.Timestamp = FMath::RoundToFloat(Action.Timestamp / TimeTolerance) * TimeTolerance;
 		}
 		SortActions();
+		UpdateMetadata();
 	}
 }
 
@@ -296,7 +681,13 @@ void UActionTimeline::UpdateMetadata()
 
 void UActionTimeline::SortActions()
 {
-	Actions.Sort([](const FRecordedAction& A, const FRecordedAction& B)
+	// Loaded and compressed timelines are usually in order already
+	if (Algo::IsSortedBy(Actions, &FRecordedAction::Timestamp))
+	{
+		return;
+	}
+
+	Actions.StableSort([](const FRecordedAction& A, const FRecordedAction& B)
 	{
 		return A.Timestamp < B.Timestamp;
 	});
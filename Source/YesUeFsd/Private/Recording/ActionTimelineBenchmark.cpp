@@ -0,0 +1,165 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Recording/ActionTimeline.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Algo/IsSorted.h"
+#include "HAL/FileManager.h"
+
+#if !UE_BUILD_SHIPPING
+
+namespace ActionTimelineBenchmark
+{
+	/**
+	 * Record a session the way UActionRecorder does: a movement and a rotation action per
+	 * recording interval, appended in time order
+	 */
+	void RecordSession(UActionTimeline& Timeline, int32 NumIntervals, float Interval, double& OutWorstAddSeconds)
+	{
+		FRandomStream Random(1234);
+		FAutoDriverMoveParams MoveParams;
+		FAutoDriverRotateParams RotateParams;
+
+		OutWorstAddSeconds = 0.0;
+		for (int32 i = 0; i < NumIntervals; ++i)
+		{
+			const float Timestamp = i * Interval;
+			const FVector Location(Random.FRandRange(-50000.0f, 50000.0f), Random.FRandRange(-50000.0f, 50000.0f), 100.0f);
+			const FRotator Rotation(0.0f, Random.FRandRange(-180.0f, 180.0f), 0.0f);
+
+			const double Start = FPlatformTime::Seconds();
+			Timeline.AddMovementAction(Timestamp, Location, MoveParams);
+			Timeline.AddRotationAction(Timestamp, Rotation, RotateParams);
+			OutWorstAddSeconds = FMath::Max(OutWorstAddSeconds, (FPlatformTime::Seconds() - Start) * 0.5);
+
+			// Playback and UI poll the duration every frame
+			Timeline.GetDuration();
+		}
+	}
+
+	/** The previous AddAction: append, full sort, then a linear scan for the duration */
+	double RecordSessionFullSort(const TArray<FRecordedAction>& Source, int32 NumActions)
+	{
+		TArray<FRecordedAction> Actions;
+		float Duration = 0.0f;
+
+		const double Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumActions; ++i)
+		{
+			Actions.Add(Source[i]);
+			Actions.Sort([](const FRecordedAction& A, const FRecordedAction& B)
+			{
+				return A.Timestamp < B.Timestamp;
+			});
+
+			Duration = 0.0f;
+			for (const FRecordedAction& Action : Actions)
+			{
+				Duration = FMath::Max(Duration, Action.Timestamp);
+			}
+		}
+		return FPlatformTime::Seconds() - Start;
+	}
+
+	void Run(const TArray<FString>& Args)
+	{
+		const float Hours = Args.Num() > 0 ? FMath::Max(FCString::Atof(*Args[0]), 0.01f) : 1.0f;
+		const float RateHz = Args.Num() > 1 ? FMath::Clamp(FCString::Atof(*Args[1]), 1.0f, 1000.0f) : 10.0f;
+		const float Interval = 1.0f / RateHz;
+		const int32 NumIntervals = FMath::CeilToInt32(Hours * 3600.0f * RateHz);
+
+		UActionTimeline* Timeline = NewObject<UActionTimeline>();
+
+		double WorstAddSeconds = 0.0;
+		const double RecordStart = FPlatformTime::Seconds();
+		RecordSession(*Timeline, NumIntervals, Interval, WorstAddSeconds);
+		const double RecordSeconds = FPlatformTime::Seconds() - RecordStart;
+
+		const int32 NumActions = Timeline->GetActionCount();
+		UE_LOG(LogTemp, Log, TEXT("Timeline Benchmark: %.2f h at %.0f Hz | %d actions in %.3f s | %.3f us/add (worst %.3f us) | duration %.1f s"),
+			Hours, RateHz, NumActions, RecordSeconds,
+			RecordSeconds / FMath::Max(NumActions, 1) * 1.0e6,
+			WorstAddSeconds * 1.0e6,
+			Timeline->GetDuration());
+
+		// Late arrivals take the binary insertion path
+		FRandomStream Random(5678);
+		const int32 NumLate = FMath::Min(1000, NumActions);
+		const double LateStart = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumLate; ++i)
+		{
+			Timeline->AddAction(FRecordedAction(Random.FRandRange(0.0f, Timeline->GetDuration()), TEXT("Custom"), TEXT("Late"), FString()));
+		}
+		const double LateSeconds = FPlatformTime::Seconds() - LateStart;
+
+		UE_LOG(LogTemp, Log, TEXT("Timeline Benchmark: %d out-of-order inserts | %.3f us/insert | sorted: %s"),
+			NumLate,
+			LateSeconds / FMath::Max(NumLate, 1) * 1.0e6,
+			Algo::IsSortedBy(Timeline->GetActions(), &FRecordedAction::Timestamp) ? TEXT("yes") : TEXT("NO"));
+
+		// The old full-sort path is quadratic; compare on the first few minutes only
+		const int32 NumBaseline = FMath::Min(NumActions, 6000);
+		const double BaselineSeconds = RecordSessionFullSort(Timeline->GetActions(), NumBaseline);
+		UE_LOG(LogTemp, Log, TEXT("Timeline Benchmark: full sort per add, first %d actions | %.3f s | %.3f us/add"),
+			NumBaseline, BaselineSeconds, BaselineSeconds / FMath::Max(NumBaseline, 1) * 1.0e6);
+
+		// On-disk size and encode cost of both formats
+		const double JsonStart = FPlatformTime::Seconds();
+		const FString Json = Timeline->ExportToJSON();
+		const double JsonSeconds = FPlatformTime::Seconds() - JsonStart;
+		const int64 JsonBytes = FTCHARToUTF8(*Json).Length();
+
+		TArray<uint8> Binary;
+		const double BinaryStart = FPlatformTime::Seconds();
+		Timeline->ExportToBinary(Binary);
+		const double BinarySeconds = FPlatformTime::Seconds() - BinaryStart;
+
+		UE_LOG(LogTemp, Log, TEXT("Timeline Benchmark: JSON %lld bytes (%.1f B/action, %.3f s) | binary %d bytes (%.1f B/action, %.3f s)"),
+			JsonBytes, static_cast<double>(JsonBytes) / FMath::Max(Timeline->GetActionCount(), 1), JsonSeconds,
+			Binary.Num(), static_cast<double>(Binary.Num()) / FMath::Max(Timeline->GetActionCount(), 1), BinarySeconds);
+	}
+}
+
+namespace ActionTimelineConvert
+{
+	/** Load a timeline and save it again; the format of each side follows its extension */
+	void Run(const TArray<FString>& Args)
+	{
+		if (Args.Num() < 2)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Usage: AutoDriver.Timeline.Convert <InFile> <OutFile>"));
+			return;
+		}
+
+		UActionTimeline* Timeline = NewObject<UActionTimeline>();
+		if (!Timeline->LoadFromFile(Args[0]))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Timeline Convert: failed to load %s"), *Args[0]);
+			return;
+		}
+
+		if (!Timeline->SaveToFile(Args[1]))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Timeline Convert: failed to save %s"), *Args[1]);
+			return;
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("Timeline Convert: %s (%lld bytes) -> %s (%lld bytes), %d actions"),
+			*Args[0], IFileManager::Get().FileSize(*Args[0]),
+			*Args[1], IFileManager::Get().FileSize(*Args[1]),
+			Timeline->GetActionCount());
+	}
+}
+
+static FAutoConsoleCommand ActionTimelineConvertCommand(
+	TEXT("AutoDriver.Timeline.Convert"),
+	TEXT("Convert a timeline file between JSON and binary (.adtb). Usage: AutoDriver.Timeline.Convert <InFile> <OutFile>"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&ActionTimelineConvert::Run));
+
+static FAutoConsoleCommand ActionTimelineBenchmarkCommand(
+	TEXT("AutoDriver.Timeline.Benchmark"),
+	TEXT("Record a synthetic session into an action timeline and measure add cost. Usage: AutoDriver.Timeline.Benchmark [Hours=1] [RateHz=10]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&ActionTimelineBenchmark::Run));
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,112 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Recording/MappedTimeline.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Algo/BinarySearch.h"
+
+FMappedTimeline::~FMappedTimeline()
+{
+	// The region must go before the file it maps
+	Region.Reset();
+	FileHandle.Reset();
+}
+
+TUniquePtr<FMappedTimeline> FMappedTimeline::Open(const FString& FilePath)
+{
+	using namespace TimelineBinary;
+
+	TUniquePtr<FMappedTimeline> Timeline(new FMappedTimeline());
+
+	Timeline->FileHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+	if (!Timeline->FileHandle)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Mapped timeline: cannot open %s"), *FilePath);
+		return nullptr;
+	}
+
+	const int64 FileSize = Timeline->FileHandle->GetFileSize();
+	if (FileSize > MAX_int32)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Mapped timeline: %s is larger than 2 GB"), *FilePath);
+		return nullptr;
+	}
+
+	Timeline->Region.Reset(Timeline->FileHandle->MapRegion(0, FileSize));
+	if (!Timeline->Region)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Mapped timeline: cannot map %s"), *FilePath);
+		return nullptr;
+	}
+
+	Timeline->Data = MakeArrayView(Timeline->Region->GetMappedPtr(), static_cast<int32>(Timeline->Region->GetMappedSize()));
+	if (!ReadFileHeader(Timeline->Data, Timeline->FileHeader))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Mapped timeline: %s is not a binary timeline"), *FilePath);
+		return nullptr;
+	}
+
+	// Headers only: CRCs are checked as chunks are decoded. ScanChunks has already rejected
+	// headers whose counts or times the file cannot hold, so the sums below stay bounded.
+	TArray<FChunkLocation> AllChunks;
+	int64 ValidSize = 0;
+	ScanChunks(Timeline->Data, AllChunks, ValidSize, false);
+
+	if (ValidSize < Timeline->Data.Num())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Mapped timeline: ignoring %lld trailing bytes after the last complete chunk of %s"),
+			Timeline->Data.Num() - ValidSize, *FilePath);
+	}
+
+	for (const FChunkLocation& Chunk : AllChunks)
+	{
+		if (Chunk.Header.Type == EChunkType::Metadata)
+		{
+			const TConstArrayView<uint8> Payload = Timeline->Data.Slice(static_cast<int32>(Chunk.PayloadOffset), static_cast<int32>(Chunk.Header.PayloadSize));
+			if (!VerifyChunk(Chunk.Header, Payload) || !ReadMetadata(Payload, Timeline->Metadata))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Mapped timeline: skipping corrupt metadata chunk in %s"), *FilePath);
+			}
+		}
+		else if (Chunk.Header.Type == EChunkType::Actions && Chunk.Header.ActionCount > 0)
+		{
+			// Seeking relies on chunks following each other in time
+			if (Timeline->Chunks.Num() > 0 && Chunk.Header.FirstTimestamp < Timeline->Chunks.Last().Header.LastTimestamp)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Mapped timeline: chunks of %s are not in time order"), *FilePath);
+				return nullptr;
+			}
+
+			Timeline->Chunks.Add(Chunk);
+			Timeline->ActionCount += Chunk.Header.ActionCount;
+		}
+	}
+
+	Timeline->Metadata.ActionCount = static_cast<int32>(FMath::Min<int64>(Timeline->ActionCount, MAX_int32));
+	Timeline->Metadata.Duration = Timeline->Chunks.Num() > 0 ? FMath::Max(0.0f, Timeline->Chunks.Last().Header.LastTimestamp) : 0.0f;
+
+	return Timeline;
+}
+
+int32 FMappedTimeline::FindChunkAfter(float Time) const
+{
+	return Algo::UpperBoundBy(Chunks, Time, [](const TimelineBinary::FChunkLocation& Chunk)
+	{
+		return Chunk.Header.LastTimestamp;
+	});
+}
+
+bool FMappedTimeline::DecodeChunk(int32 ChunkIndex, TArray<FRecordedAction>& OutActions) const
+{
+	OutActions.Reset();
+	if (!Chunks.IsValidIndex(ChunkIndex))
+	{
+		return false;
+	}
+
+	const TimelineBinary::FChunkLocation& Chunk = Chunks[ChunkIndex];
+	const TConstArrayView<uint8> Payload = Data.Slice(static_cast<int32>(Chunk.PayloadOffset), static_cast<int32>(Chunk.Header.PayloadSize));
+
+	return TimelineBinary::VerifyChunk(Chunk.Header, Payload)
+		&& TimelineBinary::ReadActions(FileHeader, Chunk.Header, Payload, OutActions);
+}
@@ -0,0 +1,577 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Recording/TimelineBinaryFormat.h"
+#include "Misc/Crc.h"
+#include "Misc/Paths.h"
+
+namespace TimelineBinary
+{
+	const TCHAR* const FileExtension = TEXT("adtb");
+
+	namespace
+	{
+		/** Variant index of each payload kind, stored as the record's kind byte */
+		constexpr uint8 CustomKind = static_cast<uint8>(FRecordedActionPayload::IndexOfType<FEmptyVariantState>());
+		constexpr uint8 MoveKind = static_cast<uint8>(FRecordedActionPayload::IndexOfType<FAutoDriverMoveParams>());
+		constexpr uint8 RotateKind = static_cast<uint8>(FRecordedActionPayload::IndexOfType<FAutoDriverRotateParams>());
+		constexpr uint8 InputKind = static_cast<uint8>(FRecordedActionPayload::IndexOfType<FAutoDriverInputParams>());
+		constexpr uint8 UIClickKind = static_cast<uint8>(FRecordedActionPayload::IndexOfType<FUIClickParams>());
+
+		/** Map float bits to unsigned integers in the same order as the floats */
+		uint32 ToOrderedBits(float Value)
+		{
+			uint32 Bits;
+			FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+			return (Bits & 0x80000000u) ? ~Bits : (Bits | 0x80000000u);
+		}
+
+		float FromOrderedBits(uint32 Ordered)
+		{
+			const uint32 Bits = (Ordered & 0x80000000u) ? (Ordered & 0x7FFFFFFFu) : ~Ordered;
+			float Value;
+			FMemory::Memcpy(&Value, &Bits, sizeof(Value));
+			return Value;
+		}
+
+		uint64 ZigZag(int64 Value)
+		{
+			return (static_cast<uint64>(Value) << 1) ^ static_cast<uint64>(Value >> 63);
+		}
+
+		int64 UnZigZag(uint64 Value)
+		{
+			return static_cast<int64>(Value >> 1) ^ -static_cast<int64>(Value & 1);
+		}
+
+		void WriteVarUInt(TArray<uint8>& Out, uint64 Value)
+		{
+			while (Value >= 0x80)
+			{
+				Out.Add(static_cast<uint8>(Value) | 0x80);
+				Value >>= 7;
+			}
+			Out.Add(static_cast<uint8>(Value));
+		}
+
+		void WriteVarInt(TArray<uint8>& Out, int64 Value)
+		{
+			WriteVarUInt(Out, ZigZag(Value));
+		}
+
+		template <typename T>
+		void WriteRaw(TArray<uint8>& Out, T Value)
+		{
+			Out.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+		}
+
+		void WriteString(TArray<uint8>& Out, const FString& Value)
+		{
+			const FTCHARToUTF8 Utf8(*Value);
+			WriteVarUInt(Out, Utf8.Length());
+			Out.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+		}
+
+		/** Bounds-checked cursor; reads past the end set bError and return zeroes */
+		struct FReader
+		{
+			TConstArrayView<uint8> Data;
+			int64 Pos = 0;
+			bool bError = false;
+
+			explicit FReader(TConstArrayView<uint8> InData)
+				: Data(InData)
+			{
+			}
+
+			bool IsAtEnd() const { return Pos == Data.Num(); }
+
+			uint64 ReadVarUInt()
+			{
+				uint64 Value = 0;
+				for (int32 Shift = 0; Shift < 64; Shift += 7)
+				{
+					if (Pos >= Data.Num())
+					{
+						bError = true;
+						return 0;
+					}
+
+					const uint8 Byte = Data[Pos++];
+					Value |= static_cast<uint64>(Byte & 0x7F) << Shift;
+					if ((Byte & 0x80) == 0)
+					{
+						return Value;
+					}
+				}
+
+				bError = true;
+				return 0;
+			}
+
+			int64 ReadVarInt()
+			{
+				return UnZigZag(ReadVarUInt());
+			}
+
+			template <typename T>
+			T ReadRaw()
+			{
+				T Value{};
+				if (Pos + static_cast<int64>(sizeof(T)) > Data.Num())
+				{
+					bError = true;
+					return Value;
+				}
+
+				FMemory::Memcpy(&Value, Data.GetData() + Pos, sizeof(T));
+				Pos += sizeof(T);
+				return Value;
+			}
+
+			FString ReadString()
+			{
+				const uint64 Length = ReadVarUInt();
+				if (bError || Length > static_cast<uint64>(Data.Num() - Pos))
+				{
+					bError = true;
+					return FString();
+				}
+
+				const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data.GetData() + Pos), static_cast<int32>(Length));
+				Pos += Length;
+				return FString(Converted.Length(), Converted.Get());
+			}
+
+			/** Index into a name table, checked against its size */
+			const FString& ReadName(const TArray<FString>& Names)
+			{
+				static const FString Empty;
+				const uint64 Index = ReadVarUInt();
+				if (bError || Index >= static_cast<uint64>(Names.Num()))
+				{
+					bError = true;
+					return Empty;
+				}
+				return Names[static_cast<int32>(Index)];
+			}
+		};
+
+		void WriteChunkHeader(const FChunkHeader& Header, TArray<uint8>& Out)
+		{
+			WriteRaw(Out, Header.Magic);
+			WriteRaw(Out, static_cast<uint32>(Header.Type));
+			WriteRaw(Out, Header.PayloadSize);
+			WriteRaw(Out, Header.ActionCount);
+			WriteRaw(Out, Header.FirstTimestamp);
+			WriteRaw(Out, Header.LastTimestamp);
+			WriteRaw(Out, Header.Crc);
+		}
+
+		/** CRC of the header fields that describe the chunk, then of its payload */
+		uint32 ComputeChunkCrc(const FChunkHeader& Header, TConstArrayView<uint8> Payload)
+		{
+			const uint32 Type = static_cast<uint32>(Header.Type);
+			uint32 Crc = FCrc::MemCrc32(&Type, sizeof(Type));
+			Crc = FCrc::MemCrc32(&Header.PayloadSize, sizeof(Header.PayloadSize), Crc);
+			Crc = FCrc::MemCrc32(&Header.ActionCount, sizeof(Header.ActionCount), Crc);
+			Crc = FCrc::MemCrc32(&Header.FirstTimestamp, sizeof(Header.FirstTimestamp), Crc);
+			Crc = FCrc::MemCrc32(&Header.LastTimestamp, sizeof(Header.LastTimestamp), Crc);
+			return FCrc::MemCrc32(Payload.GetData(), Payload.Num(), Crc);
+		}
+
+		/** Checks that need no payload: every action takes at least one payload byte and timestamps are ordered */
+		bool IsPlausibleHeader(const FChunkHeader& Header)
+		{
+			return Header.Magic == ChunkMagic
+				&& Header.ActionCount <= Header.PayloadSize
+				&& Header.FirstTimestamp <= Header.LastTimestamp;
+		}
+
+		void WriteChunk(FChunkHeader Header, TConstArrayView<uint8> Payload, TArray<uint8>& Out)
+		{
+			Header.PayloadSize = Payload.Num();
+			Header.Crc = ComputeChunkCrc(Header, Payload);
+			Out.Reserve(Out.Num() + FChunkHeader::Size + Payload.Num());
+			WriteChunkHeader(Header, Out);
+			Out.Append(Payload.GetData(), Payload.Num());
+		}
+
+		int64 Quantize(double Value, float Step)
+		{
+			return FMath::RoundToInt64(Value / Step);
+		}
+	}
+
+	bool IsBinaryPath(const FString& FilePath)
+	{
+		return FPaths::GetExtension(FilePath).Equals(FileExtension, ESearchCase::IgnoreCase);
+	}
+
+	void WriteFileHeader(const FFileHeader& Header, TArray<uint8>& OutData)
+	{
+		WriteRaw(OutData, Header.Magic);
+		WriteRaw(OutData, Header.Version);
+		WriteRaw(OutData, Header.PositionStep);
+		WriteRaw(OutData, Header.AngleStep);
+	}
+
+	bool ReadFileHeader(TConstArrayView<uint8> Data, FFileHeader& OutHeader)
+	{
+		FReader Reader(Data);
+		OutHeader.Magic = Reader.ReadRaw<uint32>();
+		OutHeader.Version = Reader.ReadRaw<uint32>();
+		OutHeader.PositionStep = Reader.ReadRaw<float>();
+		OutHeader.AngleStep = Reader.ReadRaw<float>();
+
+		return !Reader.bError
+			&& OutHeader.Magic == FileMagic
+			&& OutHeader.Version >= MinFileVersion && OutHeader.Version <= FileVersion
+			&& OutHeader.PositionStep > 0.0f
+			&& OutHeader.AngleStep > 0.0f;
+	}
+
+	void WriteMetadataChunk(const FRecordingMetadata& Metadata, TArray<uint8>& OutData)
+	{
+		TArray<uint8> Payload;
+		WriteString(Payload, Metadata.RecordingName);
+		WriteString(Payload, Metadata.Description);
+		WriteString(Payload, Metadata.MapName);
+		WriteRaw(Payload, Metadata.CreatedAt.GetTicks());
+
+		WriteVarUInt(Payload, Metadata.Tags.Num());
+		for (const FString& Tag : Metadata.Tags)
+		{
+			WriteString(Payload, Tag);
+		}
+
+		WriteVarUInt(Payload, Metadata.CustomData.Num());
+		for (const TPair<FString, FString>& Pair : Metadata.CustomData)
+		{
+			WriteString(Payload, Pair.Key);
+			WriteString(Payload, Pair.Value);
+		}
+
+		FChunkHeader Header;
+		Header.Type = EChunkType::Metadata;
+		WriteChunk(Header, Payload, OutData);
+	}
+
+	bool ReadMetadata(TConstArrayView<uint8> Payload, FRecordingMetadata& Metadata)
+	{
+		FReader Reader(Payload);
+		FRecordingMetadata Result = Metadata;
+		Result.RecordingName = Reader.ReadString();
+		Result.Description = Reader.ReadString();
+		Result.MapName = Reader.ReadString();
+		Result.CreatedAt = FDateTime(Reader.ReadRaw<int64>());
+
+		const uint64 NumTags = Reader.ReadVarUInt();
+		Result.Tags.Reset();
+		for (uint64 i = 0; i < NumTags && !Reader.bError; ++i)
+		{
+			Result.Tags.Add(Reader.ReadString());
+		}
+
+		const uint64 NumCustom = Reader.ReadVarUInt();
+		Result.CustomData.Reset();
+		for (uint64 i = 0; i < NumCustom && !Reader.bError; ++i)
+		{
+			FString Key = Reader.ReadString();
+			Result.CustomData.Add(MoveTemp(Key), Reader.ReadString());
+		}
+
+		if (Reader.bError || !Reader.IsAtEnd())
+		{
+			return false;
+		}
+
+		Metadata = MoveTemp(Result);
+		return true;
+	}
+
+	bool VerifyChunk(const FChunkHeader& Header, TConstArrayView<uint8> Payload)
+	{
+		return IsPlausibleHeader(Header)
+			&& Payload.Num() == Header.PayloadSize
+			&& ComputeChunkCrc(Header, Payload) == Header.Crc;
+	}
+
+	void ScanChunks(TConstArrayView<uint8> Data, TArray<FChunkLocation>& OutChunks, int64& OutValidSize, bool bVerifyPayloads)
+	{
+		OutChunks.Reset();
+		OutValidSize = 0;
+
+		FFileHeader FileHeader;
+		if (!ReadFileHeader(Data, FileHeader))
+		{
+			return;
+		}
+
+		int64 Offset = FFileHeader::Size;
+		OutValidSize = Offset;
+
+		while (Data.Num() - Offset >= FChunkHeader::Size)
+		{
+			FReader Reader(Data.Slice(static_cast<int32>(Offset), FChunkHeader::Size));
+			FChunkLocation Chunk;
+			Chunk.Header.Magic = Reader.ReadRaw<uint32>();
+			Chunk.Header.Type = static_cast<EChunkType>(Reader.ReadRaw<uint32>());
+			Chunk.Header.PayloadSize = Reader.ReadRaw<uint32>();
+			Chunk.Header.ActionCount = Reader.ReadRaw<uint32>();
+			Chunk.Header.FirstTimestamp = Reader.ReadRaw<float>();
+			Chunk.Header.LastTimestamp = Reader.ReadRaw<float>();
+			Chunk.Header.Crc = Reader.ReadRaw<uint32>();
+			Chunk.PayloadOffset = Offset + FChunkHeader::Size;
+
+			// Torn write or garbage after the last complete chunk
+			if (!IsPlausibleHeader(Chunk.Header) || Data.Num() - Chunk.PayloadOffset < Chunk.Header.PayloadSize)
+			{
+				break;
+			}
+
+			if (bVerifyPayloads && !VerifyChunk(Chunk.Header, Data.Slice(static_cast<int32>(Chunk.PayloadOffset), static_cast<int32>(Chunk.Header.PayloadSize))))
+			{
+				break;
+			}
+
+			Offset = Chunk.PayloadOffset + Chunk.Header.PayloadSize;
+			OutValidSize = Offset;
+			OutChunks.Add(Chunk);
+		}
+	}
+
+	bool ReadActions(const FFileHeader& FileHeader, const FChunkHeader& ChunkHeader, TConstArrayView<uint8> Payload, TArray<FRecordedAction>& OutActions)
+	{
+		// Each record takes at least one byte, so a larger count cannot be real (and must not size an allocation)
+		if (ChunkHeader.ActionCount > static_cast<uint32>(Payload.Num()))
+		{
+			return false;
+		}
+
+		FReader Reader(Payload);
+
+		const uint64 NumNames = Reader.ReadVarUInt();
+		if (Reader.bError || NumNames > static_cast<uint64>(Payload.Num()))
+		{
+			return false;
+		}
+
+		TArray<FString> Names;
+		Names.Reserve(static_cast<int32>(NumNames));
+		for (uint64 i = 0; i < NumNames && !Reader.bError; ++i)
+		{
+			Names.Add(Reader.ReadString());
+		}
+
+		const int32 FirstNew = OutActions.Num();
+		OutActions.Reserve(FirstNew + ChunkHeader.ActionCount);
+
+		uint32 TimeBits = 0;
+		FInt64Vector Location = FInt64Vector::ZeroValue;
+		FInt64Vector Rotation = FInt64Vector::ZeroValue;
+
+		for (uint32 i = 0; i < ChunkHeader.ActionCount && !Reader.bError; ++i)
+		{
+			FRecordedAction& Action = OutActions.AddDefaulted_GetRef();
+
+			TimeBits = static_cast<uint32>(TimeBits + Reader.ReadVarInt());
+			Action.Timestamp = FromOrderedBits(TimeBits);
+			Action.ActionType = Reader.ReadName(Names);
+			Action.ActionName = Reader.ReadName(Names);
+
+			const uint8 Kind = Reader.ReadRaw<uint8>();
+			if (Kind == MoveKind)
+			{
+				FAutoDriverMoveParams Move;
+				Location.X += Reader.ReadVarInt();
+				Location.Y += Reader.ReadVarInt();
+				Location.Z += Reader.ReadVarInt();
+				Move.TargetLocation = FVector(Location.X, Location.Y, Location.Z) * FileHeader.PositionStep;
+				Move.AcceptanceRadius = Reader.ReadRaw<float>();
+				Move.SpeedMultiplier = Reader.ReadRaw<float>();
+				Move.bShouldSprint = (Reader.ReadRaw<uint8>() & 1) != 0;
+				Move.MovementMode = static_cast<EAutoDriverMovementMode>(Reader.ReadRaw<uint8>());
+				Action.Payload.Set<FAutoDriverMoveParams>(Move);
+			}
+			else if (Kind == RotateKind)
+			{
+				FAutoDriverRotateParams Rotate;
+				Rotation.X += Reader.ReadVarInt();
+				Rotation.Y += Reader.ReadVarInt();
+				Rotation.Z += Reader.ReadVarInt();
+				Rotate.TargetRotation = FRotator(Rotation.X * FileHeader.AngleStep, Rotation.Y * FileHeader.AngleStep, Rotation.Z * FileHeader.AngleStep);
+				Rotate.RotationSpeed = Reader.ReadRaw<float>();
+				Rotate.AcceptanceAngle = Reader.ReadRaw<float>();
+				Action.Payload.Set<FAutoDriverRotateParams>(Rotate);
+			}
+			else if (Kind == InputKind)
+			{
+				FAutoDriverInputParams Input;
+				Input.ActionName = FName(*Reader.ReadName(Names));
+				Input.Value = Reader.ReadRaw<float>();
+				Input.Duration = Reader.ReadRaw<float>();
+				Action.Payload.Set<FAutoDriverInputParams>(Input);
+			}
+			else if (Kind == UIClickKind)
+			{
+				FUIClickParams Click;
+				Click.ClickType = static_cast<EUIClickType>(Reader.ReadRaw<uint8>());
+				Click.ClickCount = static_cast<int32>(Reader.ReadVarInt());
+				Click.OffsetFromCenter.X = Reader.ReadRaw<double>();
+				Click.OffsetFromCenter.Y = Reader.ReadRaw<double>();
+				Click.ClickDelay = Reader.ReadRaw<float>();
+				Action.Payload.Set<FUIClickParams>(Click);
+			}
+			else if (Kind == CustomKind)
+			{
+				// A built-in type stored as JSON (written before it was decoded) gets its payload, as on JSON import
+				Action.ActionData = Reader.ReadString();
+				UActionTimeline::DecodeActionData(Action);
+			}
+			else
+			{
+				Reader.bError = true;
+			}
+
+			const uint64 NumMetadata = Reader.ReadVarUInt();
+			for (uint64 j = 0; j < NumMetadata && !Reader.bError; ++j)
+			{
+				const FString& Key = Reader.ReadName(Names);
+				Action.Metadata.Add(Key, Reader.ReadName(Names));
+			}
+		}
+
+		if (Reader.bError || !Reader.IsAtEnd())
+		{
+			OutActions.SetNum(FirstNew, EAllowShrinking::No);
+			return false;
+		}
+		return true;
+	}
+
+	FChunkEncoder::FChunkEncoder(const FFileHeader& InFileHeader)
+		: PositionStep(InFileHeader.PositionStep)
+		, AngleStep(InFileHeader.AngleStep)
+	{
+	}
+
+	uint32 FChunkEncoder::Intern(const FString& Name)
+	{
+		if (const uint32* Index = NameIndices.Find(Name))
+		{
+			return *Index;
+		}
+
+		const uint32 Index = Names.Add(Name);
+		NameIndices.Add(Name, Index);
+		return Index;
+	}
+
+	void FChunkEncoder::Add(const FRecordedAction& Action)
+	{
+		if (NumActions == 0)
+		{
+			FirstTimestamp = Action.Timestamp;
+		}
+		LastTimestamp = Action.Timestamp;
+		++NumActions;
+
+		const uint32 TimeBits = ToOrderedBits(Action.Timestamp);
+		WriteVarInt(Records, static_cast<int64>(TimeBits) - static_cast<int64>(PreviousTimeBits));
+		PreviousTimeBits = TimeBits;
+
+		WriteVarUInt(Records, Intern(Action.ActionType));
+		WriteVarUInt(Records, Intern(Action.ActionName));
+
+		const uint8 Kind = static_cast<uint8>(Action.Payload.GetIndex());
+		WriteRaw(Records, Kind);
+
+		if (const FAutoDriverMoveParams* Move = Action.Payload.TryGet<FAutoDriverMoveParams>())
+		{
+			const FInt64Vector Location(
+				Quantize(Move->TargetLocation.X, PositionStep),
+				Quantize(Move->TargetLocation.Y, PositionStep),
+				Quantize(Move->TargetLocation.Z, PositionStep));
+			WriteVarInt(Records, Location.X - PreviousLocation.X);
+			WriteVarInt(Records, Location.Y - PreviousLocation.Y);
+			WriteVarInt(Records, Location.Z - PreviousLocation.Z);
+			PreviousLocation = Location;
+
+			WriteRaw(Records, Move->AcceptanceRadius);
+			WriteRaw(Records, Move->SpeedMultiplier);
+			WriteRaw(Records, static_cast<uint8>(Move->bShouldSprint ? 1 : 0));
+			WriteRaw(Records, static_cast<uint8>(Move->MovementMode));
+		}
+		else if (const FAutoDriverRotateParams* Rotate = Action.Payload.TryGet<FAutoDriverRotateParams>())
+		{
+			const FInt64Vector Rotation(
+				Quantize(Rotate->TargetRotation.Pitch, AngleStep),
+				Quantize(Rotate->TargetRotation.Yaw, AngleStep),
+				Quantize(Rotate->TargetRotation.Roll, AngleStep));
+			WriteVarInt(Records, Rotation.X - PreviousRotation.X);
+			WriteVarInt(Records, Rotation.Y - PreviousRotation.Y);
+			WriteVarInt(Records, Rotation.Z - PreviousRotation.Z);
+			PreviousRotation = Rotation;
+
+			WriteRaw(Records, Rotate->RotationSpeed);
+			WriteRaw(Records, Rotate->AcceptanceAngle);
+		}
+		else if (const FAutoDriverInputParams* Input = Action.Payload.TryGet<FAutoDriverInputParams>())
+		{
+			WriteVarUInt(Records, Intern(Input->ActionName.ToString()));
+			WriteRaw(Records, Input->Value);
+			WriteRaw(Records, Input->Duration);
+		}
+		else if (const FUIClickParams* Click = Action.Payload.TryGet<FUIClickParams>())
+		{
+			WriteRaw(Records, static_cast<uint8>(Click->ClickType));
+			WriteVarInt(Records, Click->ClickCount);
+			WriteRaw(Records, static_cast<double>(Click->OffsetFromCenter.X));
+			WriteRaw(Records, static_cast<double>(Click->OffsetFromCenter.Y));
+			WriteRaw(Records, Click->ClickDelay);
+		}
+		else
+		{
+			WriteString(Records, Action.ActionData);
+		}
+
+		WriteVarUInt(Records, Action.Metadata.Num());
+		for (const TPair<FString, FString>& Pair : Action.Metadata)
+		{
+			WriteVarUInt(Records, Intern(Pair.Key));
+			WriteVarUInt(Records, Intern(Pair.Value));
+		}
+	}
+
+	void FChunkEncoder::Seal(TArray<uint8>& OutData)
+	{
+		if (NumActions == 0)
+		{
+			return;
+		}
+
+		TArray<uint8> Payload;
+		Payload.Reserve(Records.Num() + Names.Num() * 16);
+		WriteVarUInt(Payload, Names.Num());
+		for (const FString& Name : Names)
+		{
+			WriteString(Payload, Name);
+		}
+		Payload.Append(Records);
+
+		FChunkHeader Header;
+		Header.Type = EChunkType::Actions;
+		Header.ActionCount = NumActions;
+		Header.FirstTimestamp = FirstTimestamp;
+		Header.LastTimestamp = LastTimestamp;
+		WriteChunk(Header, Payload, OutData);
+
+		Names.Reset();
+		NameIndices.Reset();
+		Records.Reset();
+		NumActions = 0;
+		PreviousTimeBits = 0;
+		PreviousLocation = FInt64Vector::ZeroValue;
+		PreviousRotation = FInt64Vector::ZeroValue;
+	}
+}
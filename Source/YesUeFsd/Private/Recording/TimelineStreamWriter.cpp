@@ -0,0 +1,226 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Recording/TimelineStreamWriter.h"
+#include "HAL/PlatformFileManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/Paths.h"
+
+FTimelineStreamWriter::FTimelineStreamWriter()
+	: Encoder(FileHeader)
+	, WritePipe(TEXT("TimelineStreamWriter"))
+	, PendingBytes(0)
+	, bWriteError(false)
+{
+}
+
+FTimelineStreamWriter::~FTimelineStreamWriter()
+{
+	if (IsOpen())
+	{
+		// No final metadata without the owner's; the chunks already written are complete
+		Flush();
+		WaitForWrites();
+		FileHandle.Reset();
+	}
+}
+
+bool FTimelineStreamWriter::Open(const FString& InFilePath, const FRecordingMetadata& Metadata, bool bResume)
+{
+	using namespace TimelineBinary;
+
+	if (IsOpen())
+	{
+		Close(Metadata);
+	}
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(InFilePath));
+
+	FileHeader = FFileHeader();
+	ResumeTimestamp = 0.0f;
+	NumActions = 0;
+	bWriteError = false;
+
+	int64 ValidSize = 0;
+	if (bResume && PlatformFile.FileExists(*InFilePath) && !ScanExisting(InFilePath, ValidSize))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Timeline stream: %s is not a binary timeline, not resuming it"), *InFilePath);
+		return false;
+	}
+
+	FileHandle.Reset(PlatformFile.OpenWrite(*InFilePath, ValidSize > 0, true));
+	if (!FileHandle.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Timeline stream: cannot open %s for writing"), *InFilePath);
+		return false;
+	}
+
+	if (ValidSize > 0)
+	{
+		// Cut a torn chunk off, so appended chunks follow the last complete one
+		if (!FileHandle->Truncate(ValidSize) || !FileHandle->Seek(ValidSize))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Timeline stream: cannot recover %s"), *InFilePath);
+			FileHandle.Reset();
+			return false;
+		}
+	}
+
+	FilePath = InFilePath;
+	Encoder = FChunkEncoder(FileHeader);
+
+	TArray<uint8> Data;
+	if (ValidSize == 0)
+	{
+		WriteFileHeader(FileHeader, Data);
+	}
+	WriteMetadataChunk(Metadata, Data);
+	Enqueue(MoveTemp(Data));
+	return true;
+}
+
+void FTimelineStreamWriter::Add(const FRecordedAction& Action)
+{
+	if (!IsOpen())
+	{
+		return;
+	}
+
+	if (Encoder.GetNumActions() == 0)
+	{
+		ChunkStartTimestamp = Action.Timestamp;
+	}
+
+	Encoder.Add(Action);
+	++NumActions;
+
+	if (Encoder.GetNumActions() >= MaxActionsPerChunk || Action.Timestamp - ChunkStartTimestamp >= MaxChunkSeconds)
+	{
+		Flush();
+	}
+}
+
+bool FTimelineStreamWriter::ScanExisting(const FString& InFilePath, int64& OutValidSize)
+{
+	using namespace TimelineBinary;
+
+	// The mapping is released on return, before the file is reopened for writing and truncated
+	TUniquePtr<IMappedFileHandle> MappedFile(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*InFilePath));
+	const int64 FileSize = MappedFile ? MappedFile->GetFileSize() : 0;
+	if (FileSize < FFileHeader::Size || FileSize > MAX_int32)
+	{
+		return false;
+	}
+
+	TUniquePtr<IMappedFileRegion> Region(MappedFile->MapRegion(0, FileSize));
+	if (!Region)
+	{
+		return false;
+	}
+
+	const TConstArrayView<uint8> Existing = MakeArrayView(Region->GetMappedPtr(), static_cast<int32>(Region->GetMappedSize()));
+	if (!ReadFileHeader(Existing, FileHeader))
+	{
+		return false;
+	}
+
+	TArray<FChunkLocation> Chunks;
+	ScanChunks(Existing, Chunks, OutValidSize);
+	for (const FChunkLocation& Chunk : Chunks)
+	{
+		if (Chunk.Header.Type == EChunkType::Actions)
+		{
+			ResumeTimestamp = FMath::Max(ResumeTimestamp, Chunk.Header.LastTimestamp);
+		}
+	}
+
+	if (OutValidSize < Existing.Num())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Timeline stream: dropping %lld bytes of incomplete chunk at the end of %s"),
+			Existing.Num() - OutValidSize, *InFilePath);
+	}
+
+	// The region must go before the file it maps
+	Region.Reset();
+	return true;
+}
+
+void FTimelineStreamWriter::Tick(float RecordingTime)
+{
+	if (Encoder.GetNumActions() > 0 && RecordingTime - ChunkStartTimestamp >= MaxChunkSeconds)
+	{
+		Flush();
+	}
+}
+
+void FTimelineStreamWriter::Flush()
+{
+	if (!IsOpen() || Encoder.GetNumActions() == 0)
+	{
+		return;
+	}
+
+	TArray<uint8> Data;
+	Encoder.Seal(Data);
+	Enqueue(MoveTemp(Data));
+}
+
+void FTimelineStreamWriter::Close(const FRecordingMetadata& Metadata)
+{
+	if (!IsOpen())
+	{
+		return;
+	}
+
+	Flush();
+
+	TArray<uint8> Data;
+	TimelineBinary::WriteMetadataChunk(Metadata, Data);
+	Enqueue(MoveTemp(Data));
+
+	WaitForWrites();
+	FileHandle.Reset();
+
+	if (HasWriteError())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Timeline stream: %s is incomplete, a write failed"), *FilePath);
+	}
+}
+
+void FTimelineStreamWriter::Enqueue(TArray<uint8>&& Data)
+{
+	// Backpressure: never hold more than MaxPendingBytes waiting for a slow disk
+	if (PendingBytes.load(std::memory_order_acquire) + Data.Num() > MaxPendingBytes)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("Timeline stream: waiting for %lld pending bytes"), PendingBytes.load());
+		WaitForWrites();
+	}
+
+	PendingBytes.fetch_add(Data.Num(), std::memory_order_acq_rel);
+
+	LastWrite = WritePipe.Launch(TEXT("TimelineStreamWrite"), [this, Data = MoveTemp(Data)]()
+	{
+		if (!bWriteError.load(std::memory_order_relaxed))
+		{
+			// Full flush after every chunk: a chunk is either on disk whole or detected as torn
+			if (!FileHandle->Write(Data.GetData(), Data.Num()) || !FileHandle->Flush(true))
+			{
+				bWriteError.store(true, std::memory_order_relaxed);
+				UE_LOG(LogTemp, Error, TEXT("Timeline stream: write to %s failed, recording further actions in memory only"), *FilePath);
+			}
+		}
+
+		PendingBytes.fetch_sub(Data.Num(), std::memory_order_acq_rel);
+	});
+}
+
+void FTimelineStreamWriter::WaitForWrites()
+{
+	if (LastWrite.IsValid())
+	{
+		// Pipe tasks run in order, so the last one finishing means all are done
+		LastWrite.Wait();
+		LastWrite = UE::Tasks::FTask();
+	}
+}
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "AI/Navigation/NavigationTypes.h"
 #include "AutoDriver/AutoDriverTypes.h"
 #include "AutoDriver/AutoDriverUITypes.h"
 #include "AutoDriverComponent.generated.h"
@@ -320,4 +321,7 @@ protected:
 
 	/** Release AI controller */
 	void ReleaseAIController();
+
+	/** Path from the controlled pawn to a location on the pawn's own navigation data, through the navigation cache */
+	FNavPathSharedPtr FindPathToLocation(const FVector& TargetLocation);
 };
@@ -38,6 +38,9 @@ DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Active Commands"), STAT_AutoDriver_Activ
 /** Time spent on navigation queries */
 DECLARE_CYCLE_STAT_EXTERN(TEXT("Navigation Queries"), STAT_AutoDriver_NavigationQuery, STATGROUP_AutoDriver, YESUEFSD_API);
 
+/** Navigation queries answered from an identical (or within-tolerance) query earlier in the same frame */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Nav Queries Coalesced"), STAT_AutoDriver_NavQueriesCoalesced, STATGROUP_AutoDriver, YESUEFSD_API);
+
 /** Time spent on path finding */
 DECLARE_CYCLE_STAT_EXTERN(TEXT("Path Finding"), STAT_AutoDriver_PathFinding, STATGROUP_AutoDriverDetailed, YESUEFSD_API);
 
@@ -50,6 +53,42 @@ DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Nav Cache Misses"), STAT_AutoDriver_NavC
 /** Navigation cache entries */
 DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Nav Cache Entries"), STAT_AutoDriver_NavCacheEntries, STATGROUP_AutoDriverDetailed, YESUEFSD_API);
 
+/** Path queries answered without pathfinding because both ends are on different navmesh islands */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Nav Island Rejections"), STAT_AutoDriver_NavIslandRejections, STATGROUP_AutoDriverDetailed, YESUEFSD_API);
+
+/** Path queries answered with the remainder of a cached path to the same goal (re-planning along it) */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Nav Cache Suffix Hits"), STAT_AutoDriver_NavCacheSuffixHits, STATGROUP_AutoDriverDetailed, YESUEFSD_API);
+
+/** Path queries answered by walking a cached goal tree instead of pathfinding */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Nav Goal Tree Hits"), STAT_AutoDriver_NavGoalTreeHits, STATGROUP_AutoDriverDetailed, YESUEFSD_API);
+
+/** Time spent building goal trees */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Nav Goal Tree Build"), STAT_AutoDriver_NavGoalTreeBuild, STATGROUP_AutoDriverDetailed, YESUEFSD_API);
+
+/** Random reachable points served from pre-sampled point pools */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Nav Point Pool Hits"), STAT_AutoDriver_NavPointPoolHits, STATGROUP_AutoDriverDetailed, YESUEFSD_API);
+
+/** Time spent topping up point pools */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Nav Point Pool Refill"), STAT_AutoDriver_NavPointPoolRefill, STATGROUP_AutoDriverDetailed, YESUEFSD_API);
+
+/** Reachability and path length queries answered on the cluster graph */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Nav Cluster Graph Queries"), STAT_AutoDriver_NavClusterQueries, STATGROUP_AutoDriverDetailed, YESUEFSD_API);
+
+/** Time spent building cluster graphs */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Nav Cluster Graph Build"), STAT_AutoDriver_NavClusterGraphBuild, STATGROUP_AutoDriverDetailed, YESUEFSD_API);
+
+/** Path requests handed to the time-sliced scheduler */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Nav Time-Sliced Requests"), STAT_AutoDriver_NavTimeSlicedRequests, STATGROUP_AutoDriverDetailed, YESUEFSD_API);
+
+/** Time spent advancing time-sliced path searches */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Nav Time-Sliced Search"), STAT_AutoDriver_NavTimeSlicedSearch, STATGROUP_AutoDriverDetailed, YESUEFSD_API);
+
+/** Items shown by the navigation debug overlay */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Nav Debug Overlay Items"), STAT_AutoDriver_NavDebugItems, STATGROUP_AutoDriverDetailed, YESUEFSD_API);
+
+/** Navigation cache entries dropped because the navmesh changed under them */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Nav Cache Invalidations"), STAT_AutoDriver_NavCacheInvalidations, STATGROUP_AutoDriverDetailed, YESUEFSD_API);
+
 // ========================================
 // AI Controller Stats
 // ========================================
@@ -4,11 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "AutoDriver/Commands/IAutoDriverCommand.h"
+#include "AI/Navigation/NavigationTypes.h"
 #include "MoveToLocationCommand.generated.h"
 
 class APlayerController;
 class ACharacter;
 class AAIController;
+class ANavigationData;
 
 /**
  * Move To Location Command
@@ -50,6 +52,17 @@ public:
 	UPROPERTY(BlueprintReadWrite, Category = "Auto Driver")
 	float Timeout = 30.0f;
 
+	/**
+	 * Solve long paths over several frames, starting to move on a partial path meanwhile.
+	 * Opt-in; has no effect when the subsystem's PathfindingBudgetMs is 0.
+	 */
+	UPROPERTY(BlueprintReadWrite, Category = "Auto Driver")
+	bool bTimeSlicedPathfinding = false;
+
+	/** Priority of the time-sliced path request (higher is solved first) */
+	UPROPERTY(BlueprintReadWrite, Category = "Auto Driver")
+	int32 PathPriority = 0;
+
 	// ========================================
 	// IAutoDriverCommand Interface
 	// ========================================
@@ -91,6 +104,19 @@ protected:
 	UPROPERTY()
 	TObjectPtr<AAIController> CachedAIController;
 
+	/** AI controller driving navigation movement */
+	UPROPERTY()
+	TObjectPtr<AAIController> NavigationController;
+
+	/** Outstanding time-sliced path request (INDEX_NONE if none) */
+	int32 PathRequestId = INDEX_NONE;
+
+	/** Moving on a partial path while the full one is solved */
+	bool bFollowingPartialPath = false;
+
+	/** The full path has been re-requested from where the partial path led */
+	bool bReplannedFromPartial = false;
+
 	/** Is the command running */
 	bool bIsRunning = false;
 
@@ -103,6 +129,24 @@ protected:
 	/** Execute movement using navigation */
 	bool ExecuteNavigationMovement();
 
+	/**
+	 * Act on the state of the time-sliced path request
+	 * @return False if movement could not be started at all
+	 */
+	bool UpdatePathRequest();
+
+	/** Cancel the time-sliced path request, if any */
+	void ReleasePathRequest();
+
+	/** Follow a copy of a path with the navigation controller; Path itself is never modified */
+	bool RequestPathMove(FNavPathSharedPtr Path, bool bPartial);
+
+	/** Let the navigation controller find its own path, falling back to direct movement */
+	bool RequestControllerMove();
+
+	/** Navigation data the character moves on */
+	const ANavigationData* GetAgentNavData() const;
+
 	/** Execute movement using direct control */
 	bool ExecuteDirectMovement();
 
@@ -0,0 +1,128 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FNavMeshPolyGraph;
+
+/**
+ * Navmesh Cluster Graph
+ *
+ * Two-level abstraction of a FNavMeshPolyGraph in the style of HPA*. Polygons are grouped
+ * into clusters: the connected pieces of the polygons whose centres fall in one cell of a
+ * square grid. Polygons with an edge into another cluster are entrances. The abstract graph
+ * links the entrances of each cluster by their shortest distance inside the cluster, and
+ * entrances of neighbouring clusters by the polygon edge between them.
+ *
+ * A query only searches the start and goal clusters at polygon level and the (much smaller)
+ * entrance graph in between, yet returns the same centre-to-centre distance as a search over
+ * the whole polygon graph. Edges are directed, so one-way links are honoured, unlike the
+ * island labels of the polygon graph. The abstract route can be refined into the polygon
+ * corridor on demand, expanding one cluster at a time.
+ *
+ * Distances are geometric and ignore area costs (unlike goal trees), so answers are only
+ * estimates, and only for the navigation data's default filter. The graph is tied to the
+ * polygon graph version it was built from; check IsValidFor before use.
+ *
+ * The clusters and the entrance graph are built in slices (see Build) so a large navmesh never
+ * stalls a frame; the graph answers nothing until IsComplete.
+ *
+ * Not thread-safe; build and query on the game thread.
+ */
+class YESUEFSD_API FNavClusterGraph
+{
+public:
+	/**
+	 * Prepare a build over the graph's current version; call Build to run it
+	 * @param ClusterSize Edge length of a clustering cell (cm)
+	 */
+	FNavClusterGraph(const FNavMeshPolyGraph& Graph, float ClusterSize);
+
+	/**
+	 * Build clusters, entrances and entrance edges until the graph is complete or the deadline passes
+	 * @return True once the graph is complete
+	 */
+	bool Build(const FNavMeshPolyGraph& Graph, double Deadline);
+
+	/** True once the entrance graph is built */
+	bool IsComplete() const { return Phase == EBuildPhase::Complete; }
+
+	/** True if built from the graph's current version */
+	bool IsValidFor(const FNavMeshPolyGraph& Graph) const;
+
+	/**
+	 * Shortest centre-to-centre distance between two polygon nodes. The graph must be complete.
+	 * @param OutCorridor If given, receives the polygon nodes along the route, both ends included
+	 * @return False if GoalNode cannot be reached from StartNode
+	 */
+	bool FindDistance(const FNavMeshPolyGraph& Graph, int32 StartNode, int32 GoalNode, float& OutDistance, TArray<int32>* OutCorridor = nullptr) const;
+
+	int32 GetNumClusters() const { return FMath::Max(ClusterNodeOffsets.Num() - 1, 0); }
+	int32 GetNumEntrances() const { return EntranceNodes.Num(); }
+
+	/** Approximate memory held by the graph */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	/** Build steps, in order */
+	enum class EBuildPhase : uint8
+	{
+		Clusters,
+		Entrances,
+		Edges,
+		Complete
+	};
+
+	/** Shortest-path record of a search restricted to one cluster */
+	struct FLocalRecord
+	{
+		float Cost;
+		/** Predecessor (forward search) or next node towards the source (reverse search) */
+		int32 Link;
+	};
+
+	/** Dijkstra from Source over the polygons of its own cluster, along or against edge direction */
+	void SearchCluster(const FNavMeshPolyGraph& Graph, int32 Source, bool bReverse, TMap<int32, FLocalRecord>& OutRecords) const;
+
+	/** Append the nodes after a forward search's source up to To, following predecessors */
+	static void AppendForward(const TMap<int32, FLocalRecord>& Records, int32 To, TArray<int32>& OutCorridor);
+
+	/** Polygon graph version this was built from */
+	uint32 GraphVersion = 0;
+
+	/** Polygon node count of that version */
+	int32 NumGraphNodes = 0;
+
+	/** Clustering cell edge length (cm) */
+	float CellSize = 0.0f;
+
+	/** Current build step, and the seed node, cluster or entrance it resumes at */
+	EBuildPhase Phase = EBuildPhase::Clusters;
+	int32 NextItem = 0;
+
+	/** Clustering cell of each polygon node, freed once the clusters are built */
+	TArray<FIntPoint> NodeCells;
+
+	/** Cluster of each polygon node */
+	TArray<int32> NodeClusters;
+
+	/** Entrance index of each polygon node, or INDEX_NONE */
+	TArray<int32> NodeEntrances;
+
+	/** Polygon nodes of cluster C are ClusterNodes[ClusterNodeOffsets[C] .. ClusterNodeOffsets[C + 1]) */
+	TArray<int32> ClusterNodeOffsets;
+	TArray<int32> ClusterNodes;
+
+	/** Entrances of cluster C are ClusterEntrances[ClusterEntranceOffsets[C] .. ClusterEntranceOffsets[C + 1]) */
+	TArray<int32> ClusterEntranceOffsets;
+	TArray<int32> ClusterEntrances;
+
+	/** Polygon node of each entrance */
+	TArray<int32> EntranceNodes;
+
+	/** CSR entrance graph: outgoing edges of entrance E are [EdgeOffsets[E], EdgeOffsets[E + 1]) */
+	TArray<int32> EdgeOffsets;
+	TArray<int32> EdgeTargets;
+	TArray<float> EdgeCosts;
+};
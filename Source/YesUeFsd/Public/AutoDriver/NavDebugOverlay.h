@@ -0,0 +1,100 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NavigationData.h"
+#include "Components/LineBatchComponent.h"
+
+/**
+ * Navigation Debug Overlay
+ *
+ * Retained-mode replacement for per-call DrawDebugLine / DrawDebugSphere in the navigation
+ * debug helpers. Each drawn item (a path, a failed query, a navmesh area) owns one batch of
+ * a line batch component. Its lines are generated once, when the item is added or changes;
+ * drawing the same item again (the same cached path, the same area) only extends its
+ * lifetime, so many agents redrawing their paths every frame cost a map lookup each.
+ *
+ * Drawing is gated by the AutoDriver.Nav.DebugDraw console variable; when it is 0 the
+ * helpers return before running any query.
+ *
+ * Not thread-safe; use on the game thread.
+ */
+class YESUEFSD_API FNavDebugOverlay
+{
+public:
+	/** True unless AutoDriver.Nav.DebugDraw is 0 */
+	static bool IsEnabled();
+
+	/**
+	 * Show a path query's result
+	 * @param Path Path to draw, or null to draw From -> To as a failed query
+	 * @param ExpireTime World time after which the item is removed (it always lasts at least one frame)
+	 */
+	void DrawPath(const FVector& From, const FVector& To, const FNavPathSharedPtr& Path, const FColor& Color, double ExpireTime);
+
+	/**
+	 * Show the navmesh polygons within Radius of Location, and the query area
+	 * @param ExpireTime World time after which the item is removed (it always lasts at least one frame)
+	 */
+	void DrawNavMeshArea(const ANavigationData& NavData, const FVector& Location, float Radius, double ExpireTime);
+
+	/** Forget drawn navmesh areas (the navmesh changed); they are captured again when next drawn */
+	void InvalidateNavMeshAreas();
+
+	/** Remove expired items and push added or changed ones to the line batcher */
+	void Flush(ULineBatchComponent& LineBatcher, double Now);
+
+	/** Remove all items, clearing their batches if a line batcher is given */
+	void Reset(ULineBatchComponent* LineBatcher);
+
+	int32 GetNumItems() const { return Items.Num(); }
+
+private:
+	/** Identifies an item: a path by identity, a failed query or area by quantized location */
+	struct FItemKey
+	{
+		const FNavigationPath* Path = nullptr;
+		FIntVector A = FIntVector::ZeroValue;
+		FIntVector B = FIntVector::ZeroValue;
+		int32 Radius = 0;
+
+		bool operator==(const FItemKey& Other) const
+		{
+			return Path == Other.Path && A == Other.A && B == Other.B && Radius == Other.Radius;
+		}
+
+		friend uint32 GetTypeHash(const FItemKey& Key)
+		{
+			return HashCombineFast(HashCombineFast(GetTypeHash(Key.Path), GetTypeHash(Key.A)), HashCombineFast(GetTypeHash(Key.B), GetTypeHash(Key.Radius)));
+		}
+	};
+
+	struct FItem
+	{
+		/** Line batch holding this item's lines */
+		uint32 BatchId = 0;
+		double ExpireTime = 0.0;
+		uint64 LastDrawnFrame = 0;
+		FColor Color = FColor::White;
+		/** Lines, generated when the item is added or changes and released once submitted */
+		TArray<FBatchedLine> Lines;
+		/** Keeps the drawn path (and so its key) alive */
+		FNavPathSharedPtr Path;
+		bool bNavMeshArea = false;
+		/** Lines changed since the last flush */
+		bool bDirty = true;
+		/** Lines are in the line batcher */
+		bool bSubmitted = false;
+	};
+
+	/** Find or add the item for Key, extending its lifetime */
+	FItem& Touch(const FItemKey& Key, double ExpireTime, bool& bOutAdded);
+
+	TMap<FItemKey, FItem> Items;
+
+	/** Batches of removed items, cleared on the next flush */
+	TArray<uint32> StaleBatches;
+
+	uint32 NextBatchId = 1;
+};
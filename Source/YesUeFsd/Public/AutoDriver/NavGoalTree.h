@@ -0,0 +1,158 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AI/Navigation/NavigationTypes.h"
+
+class FNavMeshPolyGraph;
+
+/**
+ * Navmesh Goal Tree
+ *
+ * Shortest-path tree over a FNavMeshPolyGraph rooted at one goal polygon: a single
+ * backwards Dijkstra run stores, for every polygon that can reach the goal, its distance
+ * to the goal and the next polygon towards it. Any number of agents heading to the same
+ * goal then get their polygon corridor by following next-hop links, without a search each.
+ *
+ * Distances weight the graph's centre-to-centre edge lengths by the area costs of the
+ * navigation data's default filter (FNavMeshPolyGraph::GetTraversalCost), so trees are
+ * only meaningful for that filter.
+ *
+ * The Dijkstra runs in slices (see Build) so a large navmesh never stalls a frame; a tree
+ * answers nothing until IsComplete. A tree is tied to the graph version it was built from;
+ * check IsValidFor before use.
+ */
+class YESUEFSD_API FNavGoalTree
+{
+public:
+	/** Prepare a Dijkstra from GoalNode over the graph's incoming edges; call Build to run it */
+	FNavGoalTree(const FNavMeshPolyGraph& Graph, int32 InGoalNode);
+
+	/**
+	 * Settle nodes until the tree is complete or the deadline passes
+	 * @return True once the tree is complete
+	 */
+	bool Build(const FNavMeshPolyGraph& Graph, double Deadline);
+
+	/** True once every node that can reach the goal is settled */
+	bool IsComplete() const { return Open.Num() == 0; }
+
+	int32 GetGoalNode() const { return GoalNode; }
+
+	/** Cache misses answered by the tree since it was built, halved whenever another tree is admitted */
+	int32 GetUses() const { return Uses; }
+
+	/** True if the tree was built from the graph's current version */
+	bool IsValidFor(const FNavMeshPolyGraph& Graph) const;
+
+	/** True if the goal can be reached from Node */
+	bool CanReachGoal(int32 Node) const { return Distances.IsValidIndex(Node) && Distances[Node] < TNumericLimits<float>::Max(); }
+
+	/** Centre-to-centre distance from Node to the goal polygon */
+	float GetDistance(int32 Node) const { return Distances[Node]; }
+
+	/**
+	 * Polygon corridor from StartNode to the goal polygon, both included
+	 * @return False if the goal cannot be reached from StartNode
+	 */
+	bool GetCorridor(const FNavMeshPolyGraph& Graph, int32 StartNode, TArray<NavNodeRef>& OutCorridor) const;
+
+	/** Approximate memory held by the tree */
+	SIZE_T GetAllocatedSize() const { return Distances.GetAllocatedSize() + NextHops.GetAllocatedSize() + Open.GetAllocatedSize(); }
+
+private:
+	friend class FNavGoalTreeCache;
+
+	/** Open-list entry; ordered so the TArray heap pops the smallest distance first */
+	struct FQueueItem
+	{
+		float Distance;
+		int32 Node;
+
+		bool operator<(const FQueueItem& Other) const { return Distance < Other.Distance; }
+	};
+
+	int32 GoalNode = INDEX_NONE;
+	uint32 GraphVersion = 0;
+	int32 Uses = 0;
+
+	/** Dijkstra frontier, emptied (and freed) once the tree is complete */
+	TArray<FQueueItem> Open;
+
+	/** Distance to the goal per node (float max when unreachable) */
+	TArray<float> Distances;
+
+	/** Next node towards the goal per node (INDEX_NONE for the goal and unreachable nodes) */
+	TArray<int32> NextHops;
+};
+
+/**
+ * Navmesh Goal Tree Cache
+ *
+ * Small set of goal trees for one navmesh. A goal only gets a tree once it has been
+ * requested MinRequests times, so one-off destinations keep going through regular
+ * pathfinding and only shared destinations (swarms, rally points) pay for a full Dijkstra.
+ *
+ * Trees are not built by the request that qualifies them: the goal is queued and BuildPending
+ * advances queued trees within a time budget (the subsystem spends the path scheduler's frame
+ * budget on it). Until a tree is complete, requests fall back to regular pathfinding.
+ *
+ * When the set is full, a queued goal must have been requested more often than the least
+ * used tree, which it then replaces; uses of the remaining trees are halved on every
+ * replacement so popularity ages. A working set slightly larger than MaxTrees therefore
+ * keeps its most requested trees instead of rebuilding on every miss.
+ *
+ * Not thread-safe; use on the game thread alongside the polygon graph.
+ */
+class YESUEFSD_API FNavGoalTreeCache
+{
+public:
+	explicit FNavGoalTreeCache(int32 InMaxTrees = 16, int32 InMinRequests = 3);
+
+	/**
+	 * Get the complete tree for a goal polygon. Counts as a request, and queues a build once
+	 * the goal has been requested often enough.
+	 * @return Tree valid for the graph's current version, or nullptr (none yet, or still building)
+	 */
+	const FNavGoalTree* Find(const FNavMeshPolyGraph& Graph, int32 GoalNode);
+
+	/**
+	 * Advance queued builds, oldest first, until they are done or the deadline passes.
+	 * Completed trees join the set.
+	 */
+	void BuildPending(const FNavMeshPolyGraph& Graph, double Deadline);
+
+	/** True if builds are queued */
+	bool HasPendingBuilds() const { return Pending.Num() > 0; }
+
+	/** Drop all trees, queued builds and request counts */
+	void Reset();
+
+	int32 GetNumTrees() const { return Trees.Num(); }
+
+	/** Approximate memory held by the trees */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	/** Whether a goal with RequestCount requests may take a slot in the set */
+	bool CanAdmit(int32 RequestCount) const;
+
+	/** Add a completed tree, replacing the least used one when full */
+	void Admit(TUniquePtr<FNavGoalTree> Tree);
+
+	/** Complete trees */
+	TArray<TUniquePtr<FNavGoalTree>> Trees;
+
+	/** Trees being built, oldest first */
+	TArray<TUniquePtr<FNavGoalTree>> Pending;
+
+	/** Requests per goal node that has no tree yet */
+	TMap<int32, int32> RequestCounts;
+
+	/** Graph version the trees and request counts refer to */
+	uint32 GraphVersion = 0;
+
+	int32 MaxTrees;
+	int32 MinRequests;
+};
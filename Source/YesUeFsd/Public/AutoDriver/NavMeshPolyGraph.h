@@ -0,0 +1,206 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AI/Navigation/NavigationTypes.h"
+
+class ANavigationData;
+class ARecastNavMesh;
+
+/**
+ * Navmesh Polygon Graph
+ *
+ * Compact adjacency graph over the polygons of a Recast navmesh: one node per polygon
+ * (including off-mesh link polygons), edges weighted by the distance between polygon
+ * centres, stored in CSR form. Every node carries a connected-component label, so two
+ * polygons on different navmesh islands can be told apart with two lookups instead of
+ * a failed A* search.
+ *
+ * Components are computed over the undirected graph. One-way links therefore merge
+ * islands, which can only turn a "disconnected" answer into "maybe connected", never
+ * the reverse.
+ *
+ * Edge costs are geometric lengths. Each node also records its area and that area's cost
+ * under the navigation data's default query filter, so searches that stand in for
+ * FindPathSync (goal trees, time-sliced requests) can weight edges like Detour does; see
+ * GetTraversalCost.
+ *
+ * Polygon data is kept per tile. After a rebuild only tiles overlapping the dirty
+ * regions (plus the tiles linked to them) are re-extracted; the flat arrays and
+ * labels are then regenerated in O(nodes + edges).
+ *
+ * Not thread-safe; build and query on the game thread.
+ */
+class YESUEFSD_API FNavMeshPolyGraph
+{
+public:
+	/**
+	 * Extract the whole graph from navigation data
+	 * @return False if the navigation data is not a Recast navmesh
+	 */
+	bool Build(const ANavigationData& NavData);
+
+	/** Record a navmesh region that is about to be rebuilt; the graph is unusable until OnNavMeshRebuilt */
+	void MarkDirty(const FBox& DirtyBounds);
+
+	/** Navmesh generation finished: refresh the tiles touched by the recorded dirty regions */
+	void OnNavMeshRebuilt(const ANavigationData& NavData);
+
+	/** True once built and not waiting for a rebuild to finish */
+	bool IsReady() const { return bBuilt && !bStale; }
+
+	/** True while marked dirty and waiting for OnNavMeshRebuilt */
+	bool IsStale() const { return bStale; }
+
+	/**
+	 * Whether two locations are known to be on different navmesh islands.
+	 * Both points are projected with the navigation data's default query extent;
+	 * returns false whenever that is not conclusive (graph not ready, projection failed).
+	 */
+	bool AreDisconnected(const ANavigationData& NavData, const FVector& From, const FVector& To) const;
+
+	/**
+	 * Project a location onto the navmesh and find its node
+	 * @return False if the location is off the navmesh or its polygon is unknown to the graph
+	 */
+	bool ProjectToNode(const ANavigationData& NavData, const FVector& Location, FNavLocation& OutLocation, int32& OutNode) const;
+
+	// ========================================
+	// Graph Access
+	// ========================================
+
+	/** Node index for a polygon, or INDEX_NONE */
+	int32 FindNode(NavNodeRef PolyRef) const
+	{
+		const int32* Node = NodeLookup.Find(PolyRef);
+		return Node ? *Node : INDEX_NONE;
+	}
+
+	int32 GetNumNodes() const { return NodeRefs.Num(); }
+	int32 GetNumComponents() const { return NumComponents; }
+	NavNodeRef GetNodeRef(int32 Node) const { return NodeRefs[Node]; }
+	const FVector& GetNodeCenter(int32 Node) const { return NodeCenters[Node]; }
+	int32 GetComponent(int32 Node) const { return Components[Node]; }
+
+	/** Neighbouring node indices */
+	TArrayView<const int32> GetNeighbors(int32 Node) const
+	{
+		return TArrayView<const int32>(EdgeTargets.GetData() + EdgeOffsets[Node], EdgeOffsets[Node + 1] - EdgeOffsets[Node]);
+	}
+
+	/** Edge lengths (centre to centre), parallel to GetNeighbors */
+	TArrayView<const float> GetEdgeCosts(int32 Node) const
+	{
+		return TArrayView<const float>(EdgeCosts.GetData() + EdgeOffsets[Node], EdgeOffsets[Node + 1] - EdgeOffsets[Node]);
+	}
+
+	/** Nodes with an edge into Node */
+	TArrayView<const int32> GetIncoming(int32 Node) const
+	{
+		return TArrayView<const int32>(ReverseSources.GetData() + ReverseOffsets[Node], ReverseOffsets[Node + 1] - ReverseOffsets[Node]);
+	}
+
+	/** Edge lengths (centre to centre), parallel to GetIncoming */
+	TArrayView<const float> GetIncomingCosts(int32 Node) const
+	{
+		return TArrayView<const float>(ReverseCosts.GetData() + ReverseOffsets[Node], ReverseOffsets[Node + 1] - ReverseOffsets[Node]);
+	}
+
+	/** Area cost multiplier of a node under the navigation data's default query filter */
+	float GetNodeAreaCost(int32 Node) const { return NodeAreaCosts[Node]; }
+
+	/**
+	 * Cost of the edge From -> To under the default query filter, given the edge's length:
+	 * half the length through each polygon at its area cost, plus the fixed cost of entering
+	 * To's area from a different one, as Detour charges it
+	 */
+	float GetTraversalCost(int32 From, int32 To, float Length) const
+	{
+		float Cost = 0.5f * Length * (NodeAreaCosts[From] + NodeAreaCosts[To]);
+		if (NodeAreas[From] != NodeAreas[To])
+		{
+			Cost += NodeEnteringCosts[To];
+		}
+		return Cost;
+	}
+
+	/** Lowest area cost of any node; scale straight-line heuristics by it so they stay admissible */
+	float GetMinAreaCost() const { return MinAreaCost; }
+
+	/** Incremented whenever nodes or edges change, so derived data can tell it is out of date */
+	uint32 GetVersion() const { return Version; }
+
+	/** CRC of polygon refs, centres and links; identifies a navmesh build across runs */
+	uint32 GetDataHash() const { return DataHash; }
+
+	/** Approximate memory held by the graph */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	/** Polygons of one navmesh tile and their outgoing links */
+	struct FTileData
+	{
+		TArray<NavNodeRef> Polys;
+		TArray<FVector> Centers;
+		TArray<uint8> Areas;
+		/** Links of Polys[i] are Links[LinkOffsets[i] .. LinkOffsets[i + 1]) */
+		TArray<int32> LinkOffsets;
+		TArray<NavNodeRef> Links;
+		/** Other tiles reached by Links */
+		TSet<int32> LinkedTiles;
+	};
+
+	/** Re-extract one tile (empty tiles are removed) */
+	void ExtractTile(const ARecastNavMesh& NavMesh, int32 TileIndex);
+
+	/** Read the default query filter's area costs */
+	void UpdateAreaCosts(const ARecastNavMesh& NavMesh);
+
+	/** Regenerate flat node/edge arrays and component labels from the tile data */
+	void Flatten();
+
+	/** Build the incoming-edge CSR from the outgoing one */
+	void BuildReverseEdges();
+
+	/** Label connected components with a breadth-first flood fill */
+	void LabelComponents();
+
+	/** Per-tile polygon data, keyed by tile index */
+	TMap<int32, FTileData> Tiles;
+
+	/** Flat node data */
+	TArray<NavNodeRef> NodeRefs;
+	TArray<FVector> NodeCenters;
+	TArray<int32> Components;
+	TMap<NavNodeRef, int32> NodeLookup;
+
+	/** Area id, area cost and fixed entering cost per node */
+	TArray<uint8> NodeAreas;
+	TArray<float> NodeAreaCosts;
+	TArray<float> NodeEnteringCosts;
+
+	/** Default query filter costs per area id */
+	TArray<float> AreaCostTable;
+	TArray<float> EnteringCostTable;
+	float MinAreaCost = 1.0f;
+
+	/** CSR edges: outgoing edges of node N are [EdgeOffsets[N], EdgeOffsets[N + 1]) */
+	TArray<int32> EdgeOffsets;
+	TArray<int32> EdgeTargets;
+	TArray<float> EdgeCosts;
+
+	/** CSR incoming edges: sources of edges into node N are [ReverseOffsets[N], ReverseOffsets[N + 1]) */
+	TArray<int32> ReverseOffsets;
+	TArray<int32> ReverseSources;
+	TArray<float> ReverseCosts;
+
+	/** Regions dirtied since the last refresh */
+	TArray<FBox> PendingDirtyBounds;
+
+	int32 NumComponents = 0;
+	uint32 Version = 0;
+	uint32 DataHash = 0;
+	bool bBuilt = false;
+	bool bStale = false;
+};
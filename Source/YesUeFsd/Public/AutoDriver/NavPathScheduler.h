@@ -0,0 +1,150 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AI/Navigation/NavigationTypes.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class ANavigationData;
+class FNavMeshPolyGraph;
+class FNavigationQueryCache;
+
+/** State of a time-sliced path request */
+enum class ENavPathRequestStatus : uint8
+{
+	/** Unknown, cancelled or already collected request */
+	Invalid,
+	/** Search running, no path yet */
+	Pending,
+	/** Search running; a path towards the goal is available to start moving on */
+	Partial,
+	/** Full path ready */
+	Complete,
+	/** Goal unreachable */
+	Failed
+};
+
+/**
+ * Time-Sliced Path Scheduler
+ *
+ * Runs long path searches a slice at a time instead of in a single FindPathSync, so a path
+ * across a big map costs a few milliseconds per frame rather than one hitch. Each request is
+ * an incremental A* over the navmesh's polygon graph (centre-to-centre costs, straight-line
+ * heuristic); the finished polygon corridor is string-pulled by the navmesh, like goal tree
+ * paths.
+ *
+ * Every tick spends the frame budget on the pending requests in priority order (higher
+ * first, then oldest first). While a search runs, the corridor to the polygon closest to
+ * the goal so far is published as a partial path (and republished as that polygon gets
+ * much closer), so movement can start before the search is done. Partial paths start where
+ * the request started, like the full path. Finished paths go into the request's cache.
+ *
+ * A search restarts when the polygon graph changes under it and pauses while it is
+ * unavailable (navmesh rebuilding). Like goal trees, searches weight edges by the default
+ * filter's area costs (FNavMeshPolyGraph::GetTraversalCost), so finished paths agree with
+ * FindPathSync and may share its cache; only default-filter queries should be scheduled.
+ *
+ * Not thread-safe; use on the game thread.
+ */
+class YESUEFSD_API FNavPathScheduler
+{
+public:
+	/**
+	 * Queue a search
+	 * @param Cache Cache the finished path is stored in, or null
+	 * @param Priority Higher priorities are served first
+	 * @return Request id
+	 */
+	int32 Submit(const ANavigationData& NavData, FNavigationQueryCache* Cache, const FVector& From, const FVector& To, int32 Priority);
+
+	/** Add a request that is already answered (e.g. from the cache), so callers handle all results alike */
+	int32 AddFinished(FNavPathSharedPtr Path);
+
+	/**
+	 * Current state of a request. Complete and Failed results are handed out once, after which the
+	 * request is forgotten.
+	 * @param OutPath Full path when Complete, latest partial path when Partial, null otherwise
+	 */
+	ENavPathRequestStatus Poll(int32 RequestId, FNavPathSharedPtr& OutPath);
+
+	/** Drop a request */
+	void Cancel(int32 RequestId);
+
+	/**
+	 * Advance pending searches
+	 * @param BudgetSeconds Time to spend this frame; the top request always gets one slice
+	 * @param GetGraph Ready polygon graph of a navigation data, or null
+	 */
+	void Tick(double BudgetSeconds, TFunctionRef<const FNavMeshPolyGraph*(const ANavigationData*)> GetGraph);
+
+	/** Requests still searching */
+	int32 GetNumPending() const;
+
+	/** Drop all requests */
+	void Reset();
+
+private:
+	struct FNodeRecord
+	{
+		float Cost;
+		int32 Parent;
+	};
+
+	struct FQueueItem
+	{
+		/** Cost so far plus straight-line distance to the goal, scaled by the cheapest area cost */
+		float Key;
+		float Cost;
+		int32 Node;
+
+		bool operator<(const FQueueItem& Other) const { return Key < Other.Key; }
+	};
+
+	struct FRequest
+	{
+		int32 Priority = 0;
+		uint64 Sequence = 0;
+		TWeakObjectPtr<const ANavigationData> NavData;
+		FNavigationQueryCache* Cache = nullptr;
+		FVector From = FVector::ZeroVector;
+		FVector To = FVector::ZeroVector;
+
+		ENavPathRequestStatus Status = ENavPathRequestStatus::Pending;
+		FNavPathSharedPtr Path;
+		/** Frame the request finished, so results nobody collects are dropped eventually */
+		uint64 FinishedFrame = 0;
+
+		/** Search state, valid while GraphVersion matches the graph */
+		uint32 GraphVersion = 0;
+		FVector FromOnNavMesh = FVector::ZeroVector;
+		FVector ToOnNavMesh = FVector::ZeroVector;
+		int32 GoalNode = INDEX_NONE;
+		float HeuristicScale = 1.0f;
+		TArray<FQueueItem> Open;
+		TMap<int32, FNodeRecord> Visited;
+		/** Expanded node closest to the goal (straight-line), and that distance when the current partial path was published */
+		int32 BestNode = INDEX_NONE;
+		float BestDistance = TNumericLimits<float>::Max();
+		float PartialDistance = TNumericLimits<float>::Max();
+	};
+
+	/** Start (or restart) the search of a request against the graph's current version */
+	void BeginSearch(FRequest& Request, const ANavigationData& NavData, const FNavMeshPolyGraph& Graph);
+
+	/**
+	 * Expand nodes until the goal is settled, the open list runs dry or the deadline passes
+	 * @return True when the search is finished
+	 */
+	bool StepSearch(FRequest& Request, const ANavigationData& NavData, const FNavMeshPolyGraph& Graph, double Deadline);
+
+	/** String-pull the corridor from the start polygon to Node */
+	FNavPathSharedPtr BuildPath(const FRequest& Request, const ANavigationData& NavData, const FNavMeshPolyGraph& Graph, int32 Node, const FVector& End) const;
+
+	/** Store the result and release the search state */
+	void Finish(FRequest& Request, FNavPathSharedPtr Path);
+
+	TMap<int32, FRequest> Requests;
+	int32 NextRequestId = 1;
+	uint64 NextSequence = 0;
+};
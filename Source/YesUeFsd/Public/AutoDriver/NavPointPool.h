@@ -0,0 +1,87 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ANavigationData;
+class FNavMeshPolyGraph;
+
+/**
+ * Reachable Point Pool
+ *
+ * Reservoir of pre-sampled reachable navmesh points around one origin region. Draws remove
+ * a point in O(1) (swap-remove of a random slot); the owner tops the pool up outside the
+ * query path, a few samples per frame.
+ *
+ * Uniform pools are filled with the navigation data's random reachable point query around
+ * the pool centre. Stratified pools split the sampling square into a grid and take one
+ * jittered, projected point per stratum; a full cycle is drawn (in random order) before the
+ * next one is sampled, so successive draws cover the area evenly. Stratified sampling needs
+ * the polygon graph to tell reachable strata apart and falls back to uniform without it.
+ *
+ * When the polygon graph is available each point remembers its island, and draws only return
+ * points on the caller's island.
+ *
+ * Not thread-safe; use on the game thread.
+ */
+class YESUEFSD_API FNavPointPool
+{
+public:
+	/** Strata per side of the sampling square in stratified mode */
+	static constexpr int32 StrataPerSide = 8;
+
+	FNavPointPool(const FVector& InCenter, float InRadius, bool bInStratified, int32 InCapacity);
+
+	/**
+	 * Remove and return a point within Radius (2D) of Origin
+	 * @param Graph Polygon graph of the navigation data, or null
+	 * @param Island Origin's island label in Graph, or INDEX_NONE to accept any point
+	 * @return False if no pooled point qualifies within a few tries
+	 */
+	bool Draw(const FVector& Origin, float Radius, const FNavMeshPolyGraph* Graph, int32 Island, FVector& OutLocation);
+
+	/** True while the pool wants more samples */
+	bool NeedsRefill() const;
+
+	/**
+	 * Take up to MaxSamples samples
+	 * @param Graph Polygon graph of NavData, or null
+	 * @return Number of samples attempted
+	 */
+	int32 Refill(const ANavigationData& NavData, const FNavMeshPolyGraph* Graph, int32 MaxSamples);
+
+	/** Drop points inside a changed region of the navmesh */
+	void RemoveInBounds(const FBox& Bounds);
+
+	int32 Num() const { return Points.Num(); }
+
+	/** Frame the pool was last drawn from */
+	uint64 LastUsedFrame = 0;
+
+private:
+	/** Drop everything sampled against another graph version, since its island labels are stale */
+	void SyncGraph(const FNavMeshPolyGraph* Graph);
+
+	/** Restart sampling from scratch */
+	void Reset();
+
+	FVector Center;
+	float Radius;
+	bool bStratified;
+	int32 Capacity;
+
+	/** Pooled points and their island labels (INDEX_NONE without a graph) */
+	TArray<FVector> Points;
+	TArray<int32> Islands;
+
+	/** Graph version the island labels refer to (0 when sampled without a graph) */
+	uint32 GraphVersion = 0;
+
+	/** Island of the pool centre, resolved on the first refill that has a graph */
+	int32 CenterIsland = INDEX_NONE;
+	bool bCenterResolved = false;
+
+	/** Next stratum to sample in the current cycle; StrataPerSide^2 when the cycle is complete */
+	int32 NextStratum = 0;
+};
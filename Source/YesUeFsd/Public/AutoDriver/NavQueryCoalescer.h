@@ -0,0 +1,81 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AutoDriver/NavigationCache.h"
+
+/**
+ * Navigation Query Coalescer
+ *
+ * Remembers the navigation answers given during the current frame, so the same question
+ * asked again in that frame (by another BT service, decorator or script) is answered from
+ * the first computation without touching the cache locks or the navmesh. Path and
+ * reachability queries match within the tolerance, projections only when identical.
+ * Everything is forgotten when GFrameCounter advances.
+ *
+ * Queries are scoped by an opaque pointer (the cache or navigation data they ran against),
+ * so answers for different agents or filters never mix.
+ *
+ * Not thread-safe; use on the game thread.
+ */
+class YESUEFSD_API FNavQueryCoalescer
+{
+public:
+	/**
+	 * @param InTolerance Distance within which path endpoints match (cm)
+	 * @param InMaxQueriesPerFrame Answers remembered per kind and frame; later ones are not coalesced
+	 */
+	explicit FNavQueryCoalescer(float InTolerance = 100.0f, int32 InMaxQueriesPerFrame = 256);
+
+	/** Path result computed this frame for matching endpoints */
+	bool FindPath(const void* Scope, const FVector& From, const FVector& To, FNavigationQueryCache::FCacheEntry& OutEntry);
+
+	/** Remember a path result for the rest of the frame */
+	void AddPath(const void* Scope, const FNavigationQueryCache::FCacheEntry& Entry);
+
+	/** Projection computed this frame for the same location and extent */
+	bool FindProjection(const void* Scope, const FVector& Location, const FVector& Extent, FNavLocation& OutLocation, bool& bOutProjected);
+
+	/** Remember a projection result for the rest of the frame */
+	void AddProjection(const void* Scope, const FVector& Location, const FVector& Extent, const FNavLocation& Result, bool bProjected);
+
+	/** Forget this frame's answers (the navmesh changed under them) */
+	void Reset();
+
+private:
+	struct FPathQuery
+	{
+		const void* Scope;
+		FNavigationQueryCache::FCacheEntry Entry;
+	};
+
+	struct FProjectionQuery
+	{
+		const void* Scope;
+		FVector Location;
+		FVector Extent;
+		FNavLocation Result;
+		bool bProjected;
+	};
+
+	/** Forget the previous frame's answers once the frame counter moved on */
+	void SyncFrame();
+
+	FIntVector GetCell(const FVector& Location) const;
+
+	/** Answers of the current frame */
+	TArray<FPathQuery> PathQueries;
+	TArray<FProjectionQuery> ProjectionQueries;
+
+	/** (From cell, To cell) -> PathQueries index */
+	TMultiMap<TPair<FIntVector, FIntVector>, int32> PathIndex;
+
+	/** Location cell -> ProjectionQueries index */
+	TMultiMap<FIntVector, int32> ProjectionIndex;
+
+	uint64 Frame = MAX_uint64;
+	float ToleranceSquared;
+	float CellSize;
+	int32 MaxQueriesPerFrame;
+};
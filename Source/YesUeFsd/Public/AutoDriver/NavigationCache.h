@@ -5,12 +5,32 @@
 #include "CoreMinimal.h"
 #include "NavigationSystem.h"
 #include "NavigationPath.h"
+#include <atomic>
 
 /**
  * Navigation Query Cache
  *
  * LRU cache for navigation query results to avoid redundant pathfinding calculations.
- * Thread-safe for use from multiple threads.
+ * Entries live in a slot array threaded by an intrusive doubly linked list, so lookup,
+ * insertion, promotion and eviction are all O(1) regardless of capacity.
+ *
+ * Keys are the integer grid cells of both endpoints (cell size = 2 x tolerance) and compare
+ * exactly. Optionally each entry is also listed, in a separate alias index, under the other
+ * cell pairs its endpoints' tolerance reaches, so two points within tolerance still match when
+ * they straddle a cell boundary while a lookup (hit or miss) stays one or two key lookups. The
+ * cost moves to insertion and removal, which update up to 63 aliases.
+ *
+ * Thread-safe for use from multiple threads. Entries are striped over shards by the hash of
+ * the whole key, each with its own reader/writer lock and an even share of the capacity, so
+ * many agents heading to one goal spread over every shard instead of evicting each other from
+ * one. Lookups only take a read lock: a hit sets the slot's referenced bit instead of relinking
+ * it, and eviction gives referenced entries a second chance (CLOCK), so recency is approximate
+ * rather than strict LRU.
+ *
+ * A separate goal index, striped by destination cell, lists the keys of the entries whose goal
+ * lies within tolerance of each cell, so a query whose start lies on a cached path to the same
+ * goal (re-planning partway along it) can reuse the rest of that path. Both indices hold keys
+ * only; they take no capacity from the shards.
  */
 class YESUEFSD_API FNavigationQueryCache
 {
@@ -20,39 +40,114 @@ public:
 	{
 		FVector StartLocation;
 		FVector EndLocation;
-		FNavigationPath* Path;
+		/** Shared path geometry, kept alive by the cache so hits can be followed directly */
+		FNavPathSharedPtr Path;
 		float PathLength;
 		bool bIsValid;
+		/** Time the entry was inserted (hits do not refresh it) */
 		double Timestamp;
+		/** Bytes accounted for this entry when it was inserted */
+		SIZE_T AccountedSize = 0;
+		/** Bounds of the path polyline (empty for failed queries) */
+		FBox Bounds = FBox(ForceInit);
 
 		FCacheEntry()
 			: StartLocation(FVector::ZeroVector)
 			, EndLocation(FVector::ZeroVector)
-			, Path(nullptr)
 			, PathLength(0.0f)
 			, bIsValid(false)
 			, Timestamp(0.0)
 		{}
 
-		FCacheEntry(const FVector& InStart, const FVector& InEnd, FNavigationPath* InPath, float InLength, double InTimestamp)
+		FCacheEntry(const FVector& InStart, const FVector& InEnd, FNavPathSharedPtr InPath, float InLength, double InTimestamp)
 			: StartLocation(InStart)
 			, EndLocation(InEnd)
-			, Path(InPath)
+			, Path(MoveTemp(InPath))
 			, PathLength(InLength)
-			, bIsValid(InPath != nullptr && InPath->IsValid())
+			, bIsValid(Path.IsValid() && Path->IsValid())
 			, Timestamp(InTimestamp)
-		{}
+		{
+			if (bIsValid)
+			{
+				for (const FNavPathPoint& Point : Path->GetPathPoints())
+				{
+					Bounds += Point.Location;
+				}
+			}
+		}
 
+		/** Failed queries stay valid (cached "unreachable"), successful ones only while the path is up to date */
 		bool IsStillValid() const
 		{
-			return bIsValid && Path != nullptr && Path->IsValid();
+			return !bIsValid || (Path.IsValid() && Path->IsValid());
+		}
+
+		/**
+		 * Whether a navmesh change inside DirtyBounds may affect this entry.
+		 * Failed queries always are, since any change can open a route.
+		 */
+		bool IsAffectedBy(const FBox& DirtyBounds) const
+		{
+			if (!bIsValid)
+			{
+				return true;
+			}
+
+			if (!Bounds.Intersect(DirtyBounds))
+			{
+				return false;
+			}
+
+			const TArray<FNavPathPoint>& Points = Path->GetPathPoints();
+			for (int32 i = 1; i < Points.Num(); ++i)
+			{
+				const FVector Segment = Points[i].Location - Points[i - 1].Location;
+				if (FMath::LineBoxIntersection(DirtyBounds, Points[i - 1].Location, Points[i].Location, Segment))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/** Approximate memory held by this entry, including path points */
+		SIZE_T GetAllocatedSize() const
+		{
+			SIZE_T Size = sizeof(FCacheEntry);
+			if (Path.IsValid())
+			{
+				Size += sizeof(FNavigationPath) + Path->GetPathPoints().GetAllocatedSize();
+			}
+			return Size;
+		}
+	};
+
+	/** Quantized cache key: grid cells of both endpoints */
+	struct FCacheKey
+	{
+		FIntVector FromCell;
+		FIntVector ToCell;
+
+		bool operator==(const FCacheKey& Other) const
+		{
+			return FromCell == Other.FromCell && ToCell == Other.ToCell;
+		}
+
+		friend uint32 GetTypeHash(const FCacheKey& Key)
+		{
+			return HashCombineFast(GetTypeHash(Key.FromCell), GetTypeHash(Key.ToCell));
 		}
 	};
 
-	FNavigationQueryCache(int32 InMaxCacheSize = 128, float InCacheTolerance = 100.0f)
-		: MaxCacheSize(InMaxCacheSize)
-		, CacheTolerance(InCacheTolerance)
-	{}
+	/**
+	 * @param InMaxCacheSize Total entry budget, split evenly across shards
+	 * @param InCacheTolerance Distance within which endpoints match (cm)
+	 * @param bInProbeNeighborCells Also match entries whose endpoints lie in neighbouring cells (within tolerance)
+	 * @param InNumShards Number of lock stripes (clamped to the cache size); the alias and goal indices use as many
+	 */
+	FNavigationQueryCache(int32 InMaxCacheSize = 128, float InCacheTolerance = 100.0f, bool bInProbeNeighborCells = true, int32 InNumShards = 16);
+
+	~FNavigationQueryCache();
 
 	/**
 	 * Find a cached path result
@@ -63,56 +158,193 @@ public:
 	 */
 	bool FindCachedPath(const FVector& From, const FVector& To, FCacheEntry& OutEntry);
 
+	/**
+	 * Find a cached path to the same goal that passes within tolerance of From, and return the
+	 * part of it from From onwards. Used on a miss, when an agent re-plans partway along a path.
+	 * The new first leg (From to the next path point) is raycast on the path's navigation data,
+	 * so a point near the path but behind a wall or off a ledge does not get a suffix.
+	 * @param From Starting location (somewhere along a cached path)
+	 * @param To Ending location
+	 * @param QueryFilter Filter for the first-leg raycast (the filter this cache's paths were found with)
+	 * @param OutEntry Output entry holding a new path: From, then the cached path's remaining points
+	 * @return True if a suffix was found
+	 */
+	bool FindCachedSuffix(const FVector& From, const FVector& To, FSharedConstNavQueryFilter QueryFilter, FCacheEntry& OutEntry);
+
 	/**
 	 * Add a path result to the cache
 	 * @param From Starting location
 	 * @param To Ending location
-	 * @param Path Path result (can be null for failed paths) - UE 5.7: Changed to FNavigationPath*
+	 * @param Path Path result (can be null for failed paths); the cache keeps a reference to it
 	 * @param PathLength Length of the path
 	 */
-	void CachePath(const FVector& From, const FVector& To, FNavigationPath* Path, float PathLength);
+	void CachePath(const FVector& From, const FVector& To, FNavPathSharedPtr Path, float PathLength);
+
+	/**
+	 * Remove entries whose path passes through a changed region of the navmesh.
+	 * Failed (unreachable) entries are always removed.
+	 * @param DirtyBounds Region that was rebuilt; expanded by the cache tolerance
+	 * @return Number of entries removed
+	 */
+	int32 InvalidateInBounds(const FBox& DirtyBounds);
+
+	/**
+	 * Visit every entry (shard by shard, under each shard's read lock)
+	 * @param Visitor Called with each entry; must not call back into the cache
+	 */
+	void ForEachEntry(TFunctionRef<void(const FCacheEntry&)> Visitor) const;
 
 	/**
 	 * Clear the cache
 	 */
 	void Clear();
 
+	/** Generate cache key from two locations */
+	FCacheKey GenerateCacheKey(const FVector& From, const FVector& To) const;
+
+	/** Check if two locations are close enough to be considered the same */
+	bool LocationsMatch(const FVector& A, const FVector& B) const
+	{
+		return FVector::DistSquared(A, B) <= (CacheTolerance * CacheTolerance);
+	}
+
 	/**
 	 * Get cache statistics
 	 */
-	void GetCacheStats(int32& OutHits, int32& OutMisses, int32& OutEntries) const
-	{
-		FScopeLock Lock(&CacheMutex);
-		OutHits = CacheHits;
-		OutMisses = CacheMisses;
-		OutEntries = CacheEntries.Num();
-	}
+	void GetCacheStats(int32& OutHits, int32& OutMisses, int32& OutEntries) const;
 
 	/**
 	 * Reset statistics
 	 */
 	void ResetStats()
 	{
-		FScopeLock Lock(&CacheMutex);
-		CacheHits = 0;
-		CacheMisses = 0;
+		CacheHits.store(0, std::memory_order_relaxed);
+		CacheMisses.store(0, std::memory_order_relaxed);
 	}
 
 private:
-	/** Generate cache key from two locations */
-	uint64 GenerateCacheKey(const FVector& From, const FVector& To) const;
+	/** Slot in a shard's recency list */
+	struct FCacheSlot
+	{
+		FCacheKey Key;
+		FCacheEntry Entry;
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+		/** Set by readers on a hit, cleared by eviction (second chance) */
+		mutable std::atomic<bool> bReferenced{ false };
+	};
 
-	/** Check if two locations are close enough to be considered the same */
-	bool LocationsMatch(const FVector& A, const FVector& B) const
+	/** One lock stripe: an independent recency list with its own slot storage */
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FCacheShard
 	{
-		return FVector::DistSquared(A, B) <= (CacheTolerance * CacheTolerance);
-	}
+		/** Slot storage (reused through FreeSlots) */
+		TArray<FCacheSlot> Slots;
+
+		/** Key -> slot index */
+		TMap<FCacheKey, int32> KeyToSlot;
+
+		/** Unused slot indices */
+		TArray<int32> FreeSlots;
+
+		/** Most recently inserted slot */
+		int32 HeadSlot = INDEX_NONE;
+
+		/** Oldest slot, next eviction candidate */
+		int32 TailSlot = INDEX_NONE;
+
+		/** Maximum number of entries in this shard */
+		int32 MaxEntries = 0;
+
+		/** Bytes currently held by this shard's entries */
+		SIZE_T AllocatedBytes = 0;
+
+		/** Readers share, insert/remove/evict are exclusive */
+		mutable FRWLock Lock;
+
+		/** Cache owning the alias and goal indices this shard's keys are listed in */
+		const FNavigationQueryCache* Owner = nullptr;
+
+		/** Evict the oldest entry, skipping (and clearing) referenced ones once */
+		void EvictOldestEntry();
+
+		/** Remove an entry and release its memory accounting */
+		void RemoveEntry(const FCacheKey& Key);
+
+		/** Unlink a slot from the recency list */
+		void UnlinkSlot(int32 SlotIndex);
+
+		/** Link a slot at the most recent end of the list */
+		void LinkSlotAtHead(int32 SlotIndex);
+
+		/** Drop all entries */
+		void Empty();
+	};
+
+	/**
+	 * One stripe of the alias index: cell pair -> keys of the entries a query producing it may match.
+	 * Locked after a shard lock (never before), so lookups copy keys out first.
+	 */
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FKeyAliasStripe
+	{
+		TMultiMap<FCacheKey, FCacheKey> AliasToKeys;
+		mutable FRWLock Lock;
+	};
+
+	/**
+	 * One stripe of the goal index: destination cell -> keys of the entries whose goal is within tolerance of it.
+	 * Locked after a shard lock (never before), so suffix lookups copy keys out first.
+	 */
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FGoalIndexStripe
+	{
+		TMultiMap<FIntVector, FCacheKey> CellToKeys;
+		mutable FRWLock Lock;
+	};
 
-	/** Evict oldest entries when cache is full */
-	void EvictOldestEntry();
+	/** Outcome of a lookup within one shard */
+	enum class EShardLookup : uint8
+	{
+		Miss,
+		Hit,
+		/** No hit, but a matching entry whose path went stale must be removed */
+		Stale
+	};
 
-	/** Cache storage (key -> entry) */
-	TMap<uint64, FCacheEntry> CacheEntries;
+	/** Grid cell containing a location */
+	FIntVector GetCell(const FVector& Location) const;
+
+	/**
+	 * Cells that may hold a point within tolerance of Location: its own cell first,
+	 * then (when probing) the neighbouring cells the tolerance sphere reaches.
+	 * @return Number of cells written (1 to 8)
+	 */
+	int32 GetReachedCells(const FVector& Location, FIntVector OutCells[8]) const;
+
+	/** Add (or remove) an entry's aliases and goal index cells; called under the shard's write lock */
+	void IndexEntry(const FCacheKey& Key, const FCacheEntry& Entry, bool bAdd) const;
+
+	/** Shard owning a key */
+	FCacheShard& GetShard(const FCacheKey& Key) const;
+
+	/** Alias index stripe owning a cell pair */
+	FKeyAliasStripe& GetAliasStripe(const FCacheKey& Alias) const;
+
+	/** Goal index stripe owning a destination cell */
+	FGoalIndexStripe& GetGoalStripe(const FIntVector& ToCell) const;
+
+	/** Look up one key under its shard's read lock */
+	EShardLookup FindInShard(const FCacheShard& Shard, const FCacheKey& Key, const FVector& From, const FVector& To, FCacheEntry& OutEntry) const;
+
+	/** Check whether the entry under Key passes within tolerance of From (under its shard's read lock) and From can walk onto it */
+	bool FindSuffixForKey(const FCacheKey& Key, const FVector& From, const FVector& To, const FSharedConstNavQueryFilter& QueryFilter, FCacheEntry& OutEntry) const;
+
+	/** Lock stripes, indexed by key hash */
+	TArray<TUniquePtr<FCacheShard>> Shards;
+
+	/** Alias index stripes, indexed by cell pair hash */
+	TArray<TUniquePtr<FKeyAliasStripe>> AliasStripes;
+
+	/** Goal index stripes, indexed by destination cell hash */
+	TArray<TUniquePtr<FGoalIndexStripe>> GoalStripes;
 
 	/** Maximum number of cache entries */
 	int32 MaxCacheSize;
@@ -120,10 +352,13 @@ private:
 	/** Distance tolerance for cache matching (cm) */
 	float CacheTolerance;
 
-	/** Cache statistics */
-	mutable int32 CacheHits = 0;
-	mutable int32 CacheMisses = 0;
+	/** Edge length of a key cell (cm) */
+	float CellSize;
+
+	/** Alias entries under neighbouring cells so tolerance matching works across cell boundaries */
+	bool bProbeNeighborCells;
 
-	/** Thread safety */
-	mutable FCriticalSection CacheMutex;
+	/** Cache statistics, updated without taking any shard lock */
+	std::atomic<int32> CacheHits{ 0 };
+	std::atomic<int32> CacheMisses{ 0 };
 };
@@ -0,0 +1,345 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Templates/SubclassOf.h"
+#include "UObject/ObjectKey.h"
+#include "NavigationCacheSubsystem.generated.h"
+
+class ANavigationData;
+class FNavigationQueryCache;
+class FNavMeshPolyGraph;
+class FNavGoalTreeCache;
+class FNavClusterGraph;
+class FNavPointPool;
+class FNavQueryCoalescer;
+class FNavPathScheduler;
+class FNavDebugOverlay;
+class ULineBatchComponent;
+class UNavigationQueryFilter;
+
+/**
+ * Navigation Cache Subsystem
+ *
+ * Owns the navigation query caches of its world, one per navigation data instance
+ * (i.e. per supported agent) and query filter, so entries from different worlds, agent
+ * sizes or filters never mix.
+ *
+ * Also owns a polygon graph per navmesh (see FNavMeshPolyGraph) used to reject queries
+ * between disconnected navmesh islands without running A*, and a small set of goal trees
+ * per navmesh (see FNavGoalTreeCache) so agents converging on a shared destination get
+ * their paths by walking the tree instead of each running a search.
+ * A cluster graph per navmesh (see FNavClusterGraph) answers reachability and path length
+ * estimates between distant regions without a full polygon search.
+ *
+ * Queries repeated within one frame (several BT nodes or scripts asking the same question in
+ * the same tick) are answered once and shared through a per-frame coalescer (see FNavQueryCoalescer).
+ *
+ * Long path requests can be time-sliced (see FNavPathScheduler): the subsystem advances them
+ * on tick, highest priority first, within a per-frame pathfinding budget.
+ *
+ * Debug paths and navmesh areas drawn through UNavigationHelper are kept in a retained
+ * overlay (see FNavDebugOverlay) and flushed on tick to a line batch component owned by the
+ * subsystem, so only added, changed or expired items touch the line batcher.
+ *
+ * Random reachable point queries are served from per-region point pools (see FNavPointPool),
+ * which the subsystem tops up on tick within a per-frame sample budget.
+ *
+ * Keeps the caches coherent with the navmesh: regions dirtied by dynamic obstacles,
+ * streaming or nav modifiers only drop the cached paths that pass through them, so the
+ * rest of the cache stays warm. Dirty regions are applied once when dirtied and again
+ * when the rebuild finishes, which also catches queries answered from the old tiles
+ * while the rebuild was in flight.
+ *
+ * With bPersistentCache enabled, caches are written per map on world teardown and reloaded
+ * (through a memory-mapped read) at BeginPlay. Each cache is stamped with the navmesh's
+ * polygon graph hash, so a rebuilt navmesh silently discards the stale file.
+ *
+ * Configured in the [/Script/YesUeFsd.NavigationCacheSubsystem] section of DefaultYesUeFsd.ini.
+ *
+ * Usage:
+ *   UNavigationCacheSubsystem* Subsystem = UNavigationCacheSubsystem::Get(WorldContextObject);
+ *   FNavigationQueryCache& Cache = Subsystem->GetCache(NavData, FilterClass);
+ */
+UCLASS(Config = YesUeFsd)
+class YESUEFSD_API UNavigationCacheSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UNavigationCacheSubsystem();
+	virtual ~UNavigationCacheSubsystem() override;
+
+	/** Get the subsystem for a world context, or nullptr (e.g. editor worlds) */
+	static UNavigationCacheSubsystem* Get(const UObject* WorldContextObject);
+
+	// ========================================
+	// Subsystem Interface
+	// ========================================
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// ========================================
+	// Caches
+	// ========================================
+
+	/**
+	 * Get the cache for a navigation data instance and query filter, creating it on first use.
+	 * Thread-safe; the returned cache lives until the subsystem is deinitialized.
+	 * @param NavData Navigation data the queries run against
+	 * @param FilterClass Query filter (null for the navigation data's default filter)
+	 */
+	FNavigationQueryCache& GetCache(const ANavigationData* NavData, TSubclassOf<UNavigationQueryFilter> FilterClass = nullptr);
+
+	/** Clear all caches of this world */
+	void ClearCaches();
+
+	/**
+	 * Drop cached paths that pass through a changed region in any cache of this world
+	 * @return Number of entries removed
+	 */
+	int32 InvalidateInBounds(const FBox& Bounds);
+
+	/** Summed statistics over all caches of this world */
+	void GetCacheStatistics(int32& OutHits, int32& OutMisses, int32& OutEntries) const;
+
+	/** Log statistics for each cache of this world */
+	void LogCacheStatistics() const;
+
+	// ========================================
+	// Polygon Graphs
+	// ========================================
+
+	/**
+	 * Get the polygon graph (with island labels) of a navmesh, building it on first use.
+	 * Game thread only.
+	 * @return Graph ready for queries, or nullptr while the navmesh is rebuilding or if it is not a Recast navmesh
+	 */
+	FNavMeshPolyGraph* GetPolyGraph(const ANavigationData* NavData);
+
+	/**
+	 * Get the goal trees of a navmesh, creating the set on first use. Game thread only.
+	 * @return Goal tree set, or nullptr when goal trees are disabled
+	 */
+	FNavGoalTreeCache* GetGoalTrees(const ANavigationData* NavData);
+
+	/**
+	 * Get the cluster graph of a navmesh. When the polygon graph changed, a rebuild is started and
+	 * advanced from Tick within PathfindingBudgetMs per frame. Game thread only.
+	 * @return Complete cluster graph, or nullptr when disabled, the polygon graph is unavailable or the graph is still building
+	 */
+	const FNavClusterGraph* GetClusterGraph(const ANavigationData* NavData);
+
+	// ========================================
+	// Query Coalescing
+	// ========================================
+
+	/**
+	 * Get the coalescer sharing answers between identical queries of the current frame. Game thread only.
+	 * @return Coalescer, or nullptr when coalescing is disabled
+	 */
+	FNavQueryCoalescer* GetQueryCoalescer();
+
+	// ========================================
+	// Time-Sliced Pathfinding
+	// ========================================
+
+	/**
+	 * Get the scheduler advancing time-sliced path requests on tick. Game thread only.
+	 * @return Scheduler, or nullptr when the pathfinding budget is disabled
+	 */
+	FNavPathScheduler* GetPathScheduler();
+
+	/** Shorter (straight-line) queries are cheap enough to solve at once */
+	float GetTimeSliceMinDistance() const { return TimeSliceMinDistance; }
+
+	// ========================================
+	// Debug Overlay
+	// ========================================
+
+	/**
+	 * Get the debug overlay, creating it and its line batch component on first use. Game thread only.
+	 * @return Overlay, or nullptr when AutoDriver.Nav.DebugDraw is 0
+	 */
+	FNavDebugOverlay* GetDebugOverlay();
+
+	// ========================================
+	// Reachable Point Pools
+	// ========================================
+
+	/**
+	 * Draw a pre-sampled point reachable from Origin within Radius. A miss creates the pool
+	 * for Origin's region, which is filled over the next frames. Game thread only.
+	 * @param bStratified Draw from a pool that covers the area evenly instead of uniformly at random
+	 * @return False if no pooled point is available (the caller should sample directly)
+	 */
+	bool DrawReachablePoint(const ANavigationData* NavData, const FVector& Origin, float Radius, bool bStratified, FVector& OutLocation);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Navigation dirtied somewhere (the event is global, bounds are not tied to a world) */
+	void OnNavigationDirtied(const FBox& DirtyBounds);
+
+	/** Navmesh rebuild for this world finished */
+	UFUNCTION()
+	void OnNavigationGenerationFinished(ANavigationData* NavData);
+
+	/** Whether a region overlaps any navigation data of this world */
+	bool OverlapsWorldNavigation(const FBox& Bounds) const;
+
+	/** Once no rebuild is queued or running, refresh graphs still waiting for one and drop pending regions */
+	void SettleDirtyNavigation();
+
+	/** Advance queued goal tree builds until the deadline */
+	void BuildPendingGoalTrees(double Deadline);
+
+	/** Advance cluster graph builds until the deadline */
+	void BuildPendingClusterGraphs(double Deadline);
+
+	/** A cache and the names it is reported under */
+	struct FCacheInstance
+	{
+		TUniquePtr<FNavigationQueryCache> Cache;
+		FString Label;
+		/** Identity used by the persistent cache file */
+		FString NavDataName;
+		FString FilterClassPath;
+	};
+
+	/** Caches keyed by (navigation data, filter class) */
+	TMap<TPair<FObjectKey, FObjectKey>, FCacheInstance> Caches;
+
+	/** Guards Caches (not the caches themselves, which are thread-safe) */
+	mutable FRWLock CachesLock;
+
+	/** Polygon graphs keyed by navigation data; null entries mark navigation data without one */
+	TMap<FObjectKey, TUniquePtr<FNavMeshPolyGraph>> PolyGraphs;
+
+	/** Goal tree sets keyed by navigation data */
+	TMap<FObjectKey, TUniquePtr<FNavGoalTreeCache>> GoalTrees;
+
+	/** Cluster graphs keyed by navigation data */
+	TMap<FObjectKey, TUniquePtr<FNavClusterGraph>> ClusterGraphs;
+
+	/** Identifies a point pool: navigation data, origin region, radius and sampling mode */
+	struct FPointPoolKey
+	{
+		FObjectKey NavData;
+		FIntVector Region;
+		int32 Radius = 0;
+		bool bStratified = false;
+
+		bool operator==(const FPointPoolKey& Other) const
+		{
+			return NavData == Other.NavData && Region == Other.Region && Radius == Other.Radius && bStratified == Other.bStratified;
+		}
+
+		friend uint32 GetTypeHash(const FPointPoolKey& Key)
+		{
+			return HashCombineFast(HashCombineFast(GetTypeHash(Key.NavData), GetTypeHash(Key.Region)), GetTypeHash(Key.Radius * 2 + Key.bStratified));
+		}
+	};
+
+	/** Point pools by region */
+	TMap<FPointPoolKey, TUniquePtr<FNavPointPool>> PointPools;
+
+	/** Answers of the current frame, created on first use */
+	TUniquePtr<FNavQueryCoalescer> QueryCoalescer;
+
+	/** Pending time-sliced path requests, created on first use */
+	TUniquePtr<FNavPathScheduler> PathScheduler;
+
+	/** Debug items drawn through UNavigationHelper, created on first use */
+	TUniquePtr<FNavDebugOverlay> DebugOverlay;
+
+	/** Line batcher the debug overlay is flushed to */
+	UPROPERTY(Transient)
+	TObjectPtr<ULineBatchComponent> DebugLineBatcher;
+
+	/** Clear the debug overlay and unregister its line batcher */
+	void ReleaseDebugOverlay();
+
+	/** Entry budget of each cache */
+	UPROPERTY(Config)
+	int32 MaxEntriesPerCache = 1024;
+
+	/** Endpoint tolerance of each cache (cm) */
+	UPROPERTY(Config)
+	float CacheTolerance = 100.0f;
+
+	/** Answer default-filter path queries towards frequently requested goals from goal trees */
+	UPROPERTY(Config)
+	bool bUseGoalTrees = true;
+
+	/** Goal trees kept per navmesh */
+	UPROPERTY(Config)
+	int32 MaxGoalTreesPerNavData = 16;
+
+	/** Cache misses towards the same goal polygon before a tree is queued for building (within PathfindingBudgetMs per frame) */
+	UPROPERTY(Config)
+	int32 MinRequestsForGoalTree = 3;
+
+	/** Answer default-filter reachability and path length estimates on a cluster graph */
+	UPROPERTY(Config)
+	bool bUseClusterGraph = true;
+
+	/** Edge length of a cluster graph cell (cm) */
+	UPROPERTY(Config)
+	float ClusterSize = 2000.0f;
+
+	/** Share answers between identical (or within-tolerance) queries issued in the same frame */
+	UPROPERTY(Config)
+	bool bCoalesceQueries = true;
+
+	/** Answers remembered per query kind and frame; further queries that frame are not coalesced */
+	UPROPERTY(Config)
+	int32 MaxCoalescedQueriesPerFrame = 256;
+
+	/** Time spent per frame advancing time-sliced path requests and queued goal tree and cluster graph builds (ms); 0 does all of it at once */
+	UPROPERTY(Config)
+	float PathfindingBudgetMs = 2.0f;
+
+	/** Straight-line distance from which path requests are time-sliced instead of solved at once (cm) */
+	UPROPERTY(Config)
+	float TimeSliceMinDistance = 5000.0f;
+
+	/** Points kept per uniform point pool (stratified pools hold one per stratum) */
+	UPROPERTY(Config)
+	int32 PointPoolCapacity = 32;
+
+	/** Point samples taken per frame across all pools */
+	UPROPERTY(Config)
+	int32 PointPoolSamplesPerFrame = 8;
+
+	/** Point pools kept per world; the least recently used one is dropped beyond this */
+	UPROPERTY(Config)
+	int32 MaxPointPools = 256;
+
+	/** Save caches per map on teardown and reload them at BeginPlay */
+	UPROPERTY(Config)
+	bool bPersistentCache = false;
+
+	/** Cache file for the current map (under Saved/AutoDriver/NavCache) */
+	FString GetPersistentCachePath() const;
+
+	/** Load matching caches from the map's cache file */
+	void LoadPersistentCaches();
+
+	/** Write all caches whose navmesh graph is available to the map's cache file */
+	void SavePersistentCaches();
+
+	/** Dirty regions waiting for the rebuild to finish */
+	TArray<FBox> PendingDirtyBounds;
+
+	/** Set by a dirty event for this world, cleared once no rebuild is pending */
+	bool bAwaitingNavigationRebuild = false;
+
+	/** Handle for the navigation dirty event */
+	FDelegateHandle NavigationDirtyHandle;
+};
@@ -4,10 +4,14 @@
 
 #include "CoreMinimal.h"
 #include "UObject/Object.h"
+#include "AI/Navigation/NavigationTypes.h"
+#include "Templates/SubclassOf.h"
 #include "NavigationHelper.generated.h"
 
 class UNavigationSystemV1;
 class ANavigationData;
+class UNavigationQueryFilter;
+enum class ENavPathRequestStatus : uint8;
 
 /**
  * Navigation query result
@@ -55,6 +59,9 @@ struct YESUEFSD_API FNavigationQueryResult
 	}
 };
 
+/** Completion delegate for batched path queries; results are in submission order */
+DECLARE_DYNAMIC_DELEGATE_OneParam(FOnNavigationBatchComplete, const TArray<FNavigationQueryResult>&, Results);
+
 /**
  * Navigation Helper
  *
@@ -73,7 +80,8 @@ public:
 	// ========================================
 
 	/**
-	 * Check if a location is reachable from another location
+	 * Check if a location is reachable from another location.
+	 * Answered from the navigation cache, or on the navmesh's cluster graph without a path search.
 	 * @param World World context
 	 * @param From Starting location
 	 * @param To Target location
@@ -113,6 +121,25 @@ public:
 		const FVector& Location,
 		const FVector& QueryExtent = FVector(500, 500, 500));
 
+	/**
+	 * Project many locations onto the navmesh in one call.
+	 * Locations are sorted by navmesh tile and projected in tile-coherent chunks, each chunk
+	 * through one batched navmesh query, with chunks spread across worker threads.
+	 * @param WorldContextObject World context
+	 * @param Locations Locations to project
+	 * @param OutLocations Projected locations, in input order (input location where projection failed)
+	 * @param OutProjected Whether each location projected, in input order
+	 * @param QueryExtent Search extent
+	 * @return Number of locations that projected onto the navmesh
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Navigation Helper", meta = (WorldContext = "WorldContextObject"))
+	static int32 ProjectLocationsToNavMesh(
+		UObject* WorldContextObject,
+		const TArray<FVector>& Locations,
+		TArray<FVector>& OutLocations,
+		TArray<bool>& OutProjected,
+		const FVector& QueryExtent = FVector(500, 500, 500));
+
 	// ========================================
 	// Path Queries
 	// ========================================
@@ -130,6 +157,118 @@ public:
 		const FVector& From,
 		const FVector& To);
 
+	/**
+	 * Estimate the path length between two locations in microseconds, on the navmesh's cluster
+	 * graph instead of a full path search. The estimate follows polygon centres, so it is a little
+	 * longer than the string-pulled path; cached paths give the exact length. With bRefine the
+	 * route is expanded into a real path (which is cached) and its exact length returned.
+	 * Falls back to a regular path query when the cluster graph is unavailable.
+	 * @param WorldContextObject World context
+	 * @param From Starting location
+	 * @param To Target location
+	 * @param bRefine Expand the route into a string-pulled path for the exact length
+	 * @return Query result with (estimated) path length
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Navigation Helper", meta = (WorldContext = "WorldContextObject"))
+	static FNavigationQueryResult EstimatePathLength(
+		UObject* WorldContextObject,
+		const FVector& From,
+		const FVector& To,
+		bool bRefine = false);
+
+	/**
+	 * Pick the candidate target with the shortest path from an origin. Candidates on other
+	 * navmesh islands are dropped up front, and a graph search over polygon centres picks the
+	 * likely winner, whose real path (through the navigation cache) bounds the rest: only
+	 * candidates whose straight-line distance is below the best path length so far get a path
+	 * query, so the result is exact while most candidates need none.
+	 * @param WorldContextObject World context
+	 * @param Origin Starting location
+	 * @param Targets Candidate target locations
+	 * @param OutTargetIndex Index into Targets of the nearest reachable target, or INDEX_NONE
+	 * @return Query result with the winning target location and its path length
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Navigation Helper", meta = (WorldContext = "WorldContextObject"))
+	static FNavigationQueryResult FindNearestByPathLength(
+		UObject* WorldContextObject,
+		const FVector& Origin,
+		const TArray<FVector>& Targets,
+		int32& OutTargetIndex);
+
+	/**
+	 * Find a path between two locations, reusing cached path geometry when available.
+	 * The returned path is shared with the navigation cache and can be followed directly.
+	 * @param WorldContextObject World context
+	 * @param From Starting location
+	 * @param To Target location
+	 * @param NavData Navigation data for the moving agent (default instance if null)
+	 * @param FilterClass Query filter (navigation data default if null)
+	 * @return Shared path, or null if no path exists
+	 */
+	static FNavPathSharedPtr FindPath(
+		UObject* WorldContextObject,
+		const FVector& From,
+		const FVector& To,
+		const ANavigationData* NavData = nullptr,
+		TSubclassOf<UNavigationQueryFilter> FilterClass = nullptr);
+
+	/**
+	 * Find paths for a batch of start/goal pairs without blocking the game thread.
+	 * Pairs answered by the navigation cache complete immediately, duplicate pairs (within the
+	 * cache tolerance) share one query, and the rest go through the engine's async path queries.
+	 * Results fill the navigation cache. If every pair is cached, OnComplete runs before returning.
+	 * @param WorldContextObject World context
+	 * @param Starts Starting locations
+	 * @param Goals Target locations (same count as Starts)
+	 * @param OnComplete Called on the game thread with one result per pair (PathLength set on success)
+	 * @return Number of async path queries submitted
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Navigation Helper", meta = (WorldContext = "WorldContextObject"))
+	static int32 FindPathsAsync(
+		UObject* WorldContextObject,
+		const TArray<FVector>& Starts,
+		const TArray<FVector>& Goals,
+		FOnNavigationBatchComplete OnComplete);
+
+	/** C++ variant of FindPathsAsync taking any callable */
+	static int32 FindPathsAsync(
+		UObject* WorldContextObject,
+		const TArray<FVector>& Starts,
+		const TArray<FVector>& Goals,
+		TFunction<void(const TArray<FNavigationQueryResult>&)> OnComplete);
+
+	/**
+	 * Request a path that is solved a slice at a time on later frames, within the pathfinding
+	 * budget of the navigation cache subsystem, instead of blocking this frame. Cached, short
+	 * (see TimeSliceMinDistance) and filtered queries are answered right away. Poll the request
+	 * with PollPathRequest; while it is Partial, movement can start on the partial path.
+	 * Game thread only.
+	 * @param WorldContextObject World context
+	 * @param From Starting location
+	 * @param To Target location
+	 * @param Priority Higher priorities are served first
+	 * @param NavData Navigation data for the moving agent (default instance if null)
+	 * @param FilterClass Query filter (navigation data default if null)
+	 * @return Request id, or INDEX_NONE when time-slicing is unavailable (use FindPath instead)
+	 */
+	static int32 RequestPathTimeSliced(
+		UObject* WorldContextObject,
+		const FVector& From,
+		const FVector& To,
+		int32 Priority = 0,
+		const ANavigationData* NavData = nullptr,
+		TSubclassOf<UNavigationQueryFilter> FilterClass = nullptr);
+
+	/**
+	 * State of a time-sliced path request. Complete and Failed are reported once, after which
+	 * the request id is no longer valid.
+	 * @param OutPath Full path when Complete, partial path (from the request's start) when Partial
+	 */
+	static ENavPathRequestStatus PollPathRequest(UObject* WorldContextObject, int32 RequestId, FNavPathSharedPtr& OutPath);
+
+	/** Drop a time-sliced path request that is no longer needed */
+	static void CancelPathRequest(UObject* WorldContextObject, int32 RequestId);
+
 	/**
 	 * Get the straight-line distance between two locations
 	 * @param From Starting location
@@ -144,17 +283,21 @@ public:
 	// ========================================
 
 	/**
-	 * Find a random reachable location within a radius
+	 * Find a random reachable location within a radius.
+	 * Served in O(1) from a pool of pre-sampled points for Origin's region when one is available;
+	 * pools are created on first use and topped up in the background.
 	 * @param WorldContextObject World context
 	 * @param Origin Center point
 	 * @param Radius Search radius
+	 * @param bStratified Draw from a stratified pool, so successive results cover the area evenly
 	 * @return Query result with random location
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Navigation Helper", meta = (WorldContext = "WorldContextObject"))
 	static FNavigationQueryResult GetRandomReachableLocation(
 		UObject* WorldContextObject,
 		const FVector& Origin,
-		float Radius = 1000.0f);
+		float Radius = 1000.0f,
+		bool bStratified = false);
 
 	/**
 	 * Find a random location on the navigation mesh within a radius
@@ -174,7 +317,9 @@ public:
 	// ========================================
 
 	/**
-	 * Draw debug path between two locations
+	 * Draw debug path between two locations. The path comes from the navigation cache and is kept
+	 * in a batched overlay, so redrawing an unchanged path every frame is cheap. Does nothing
+	 * (not even the path query) when AutoDriver.Nav.DebugDraw is 0.
 	 * @param WorldContextObject World context
 	 * @param From Starting location
 	 * @param To Target location
@@ -190,7 +335,9 @@ public:
 		FLinearColor Color = FLinearColor::Green);
 
 	/**
-	 * Draw debug navigation mesh around a location
+	 * Draw debug navigation mesh around a location: the outlines of the polygons within Radius,
+	 * captured once per area and kept until the navmesh changes. Does nothing when
+	 * AutoDriver.Nav.DebugDraw is 0.
 	 * @param WorldContextObject World context
 	 * @param Location Center location
 	 * @param Radius Visualization radius
@@ -224,18 +371,26 @@ public:
 	static bool IsNavigationSystemAvailable(UObject* WorldContextObject);
 
 	/**
-	 * Clear navigation query cache
+	 * Clear the navigation query caches of a world
+	 * @param WorldContextObject World context
 	 */
-	UFUNCTION(BlueprintCallable, Category = "Navigation Helper")
-	static void ClearNavigationCache();
+	UFUNCTION(BlueprintCallable, Category = "Navigation Helper", meta = (WorldContext = "WorldContextObject"))
+	static void ClearNavigationCache(UObject* WorldContextObject);
 
 	/**
-	 * Get navigation cache statistics
+	 * Drop cached paths that pass through a changed region of the navmesh.
+	 * Called automatically by UNavigationCacheSubsystem when navigation is dirtied.
+	 * @param WorldContextObject World context
+	 * @param Bounds Changed region
+	 * @return Number of cache entries removed
 	 */
-	UFUNCTION(BlueprintCallable, Category = "Navigation Helper")
-	static void GetCacheStatistics(int32& OutHits, int32& OutMisses, int32& OutEntries);
+	UFUNCTION(BlueprintCallable, Category = "Navigation Helper", meta = (WorldContext = "WorldContextObject"))
+	static int32 InvalidateNavigationCacheInBounds(UObject* WorldContextObject, const FBox& Bounds);
 
-private:
-	/** Singleton navigation query cache */
-	static class FNavigationQueryCache& GetNavigationCache();
+	/**
+	 * Get navigation cache statistics for a world, summed over its per-agent/filter caches
+	 * @param WorldContextObject World context
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Navigation Helper", meta = (WorldContext = "WorldContextObject"))
+	static void GetCacheStatistics(UObject* WorldContextObject, int32& OutHits, int32& OutMisses, int32& OutEntries);
 };
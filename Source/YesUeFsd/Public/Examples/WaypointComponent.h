@@ -175,4 +175,54 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Route")
 	bool IsRouteValid() const;
+
+	/**
+	 * Compute path lengths between every pair of waypoints, one row per worker thread.
+	 * The matrix is stored on the route (and saved with it) together with a hash of the
+	 * waypoint locations, so it is reused until a waypoint moves or the route changes.
+	 * @return False if the route is invalid or navigation is unavailable or rebuilding
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Route|Path Lengths", meta = (WorldContext = "WorldContextObject"))
+	bool BuildPathLengthMatrix(UObject* WorldContextObject);
+
+	/**
+	 * Check the stored matrix still matches the current waypoints.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Route|Path Lengths")
+	bool HasValidPathLengthMatrix() const;
+
+	/**
+	 * Get the path length from one waypoint to another from the stored matrix.
+	 * Returns -1 if the matrix is stale or the path does not exist.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Route|Path Lengths")
+	float GetPathLengthBetween(int32 FromIndex, int32 ToIndex) const;
+
+	/**
+	 * Get the total path length of the route in its current order from the stored matrix.
+	 * Returns -1 if the matrix is stale or a leg is unreachable.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Route|Path Lengths")
+	float GetRoutePathLength() const;
+
+	/**
+	 * Reorder the waypoints to minimise the total path length of a lap (nearest neighbour
+	 * tour improved with 2-opt). The first waypoint stays first; bLoopRoute decides whether
+	 * the return leg counts. Requires a valid matrix, which is reordered along with the route.
+	 * @return New route path length, or -1 if the matrix is stale
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Route|Path Lengths")
+	float OptimizeWaypointOrder();
+
+protected:
+	/** Row-major path lengths between waypoints (From * Num + To), -1 where unreachable */
+	UPROPERTY(VisibleAnywhere, Category = "Route|Path Lengths")
+	TArray<float> PathLengthMatrix;
+
+	/** Hash of the waypoint locations PathLengthMatrix was computed for */
+	UPROPERTY(VisibleAnywhere, Category = "Route|Path Lengths")
+	uint32 PathLengthMatrixHash = 0;
+
+	/** Hash of the current waypoint order and locations */
+	uint32 ComputeWaypointHash() const;
 };
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Recording/ActionTimeline.h"
+#include "Recording/MappedTimeline.h"
 #include "ActionPlayback.generated.h"
 
 class UAutoDriverComponent;
@@ -104,15 +105,26 @@ public:
 
 	// Timeline Management
 
-	/** Get the current timeline being played */
+	/** Get the current timeline being played (null while streaming from a binary file) */
 	UFUNCTION(BlueprintCallable, Category = "Action Playback")
 	UActionTimeline* GetCurrentTimeline() const { return CurrentTimeline; }
 
+	/**
+	 * Play a binary timeline file (.adtb) straight from disk. The file is memory-mapped and
+	 * decoded a chunk at a time, so memory use does not grow with the recording's length.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Action Playback")
+	bool PlayFromFile(const FString& FilePath);
+
+	/** True while playing a file streamed by PlayFromFile */
+	UFUNCTION(BlueprintCallable, Category = "Action Playback")
+	bool IsStreaming() const { return MappedTimeline.IsValid(); }
+
 	/** Set the timeline to play */
 	UFUNCTION(BlueprintCallable, Category = "Action Playback")
 	void SetTimeline(UActionTimeline* Timeline);
 
-	/** Load and set timeline from file */
+	/** Load and play a timeline from file; .adtb files are streamed (see PlayFromFile) if bStreamBinaryFiles is set */
 	UFUNCTION(BlueprintCallable, Category = "Action Playback")
 	bool LoadAndPlayTimeline(const FString& FilePath);
 
@@ -215,10 +227,38 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Playback Settings")
 	float TimeTolerance;
 
+	/** LoadAndPlayTimeline streams binary timeline files instead of loading them whole */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Playback Settings")
+	bool bStreamBinaryFiles;
+
 private:
-	/** Index of next action to execute */
+	/** Index of next action to execute (in the timeline, or in StreamActions while streaming) */
 	int32 NextActionIndex;
 
+	/** File being streamed, if any (CurrentTimeline is null then) */
+	TUniquePtr<FMappedTimeline> MappedTimeline;
+
+	/** Decoded actions of the chunk being streamed */
+	TArray<FRecordedAction> StreamActions;
+
+	/** Index of the chunk in StreamActions */
+	int32 StreamChunkIndex;
+
+	/** Seek applied on the next action lookup, so StreamActions never changes under an executing action */
+	TOptional<float> PendingStreamSeek;
+
+	/** Duration of whatever is being played */
+	float GetTimelineDuration() const;
+
+	/** Next action to execute, decoding the next chunk when streaming; null at the end */
+	const FRecordedAction* PeekNextAction();
+
+	/** Move to the first action later than Time; TNumericLimits<float>::Lowest() rewinds to the start */
+	void SeekActions(float Time);
+
+	/** Decode a chunk of the streamed file into StreamActions */
+	void LoadStreamChunk(int32 ChunkIndex);
+
 	/** Initialize component references */
 	void InitializeReferences();
 
@@ -232,16 +272,16 @@ private:
 	void ExecuteAction(const FRecordedAction& Action);
 
 	/** Execute movement action */
-	void ExecuteMovementAction(const FRecordedAction& Action);
+	void ExecuteMovementAction(const FAutoDriverMoveParams& Params);
 
 	/** Execute rotation action */
-	void ExecuteRotationAction(const FRecordedAction& Action);
+	void ExecuteRotationAction(const FAutoDriverRotateParams& Params);
 
 	/** Execute input action */
-	void ExecuteInputAction(const FRecordedAction& Action);
+	void ExecuteInputAction(const FAutoDriverInputParams& Params);
 
 	/** Execute UI click action */
-	void ExecuteUIClickAction(const FRecordedAction& Action);
+	void ExecuteUIClickAction(const FString& WidgetName, const FUIClickParams& ClickParams);
 
 	/** Handle loop completion */
 	void HandleLoopCompletion();
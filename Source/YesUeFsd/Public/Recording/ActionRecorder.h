@@ -7,6 +7,7 @@
 #include "Recording/ActionTimeline.h"
 #include "AutoDriver/AutoDriverTypes.h"
 #include "AutoDriver/AutoDriverUITypes.h"
+#include "Recording/TimelineStreamWriter.h"
 #include "ActionRecorder.generated.h"
 
 class UAutoDriverComponent;
@@ -94,6 +95,20 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Action Recorder")
 	bool SaveRecording(const FString& FilePath);
 
+	/**
+	 * Stream recorded actions to a binary timeline file (.adtb) while recording, so a crash loses
+	 * at most the last second or so. Takes effect on the next StartRecording; empty disables.
+	 * @param bResume Append to an existing recording at FilePath instead of replacing it. The
+	 *        file is cut back to its last complete chunk, and recording time continues from its
+	 *        last action.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Action Recorder")
+	void SetStreamFile(const FString& FilePath, bool bResume = false);
+
+	/** True while actions are being streamed to the stream file */
+	UFUNCTION(BlueprintCallable, Category = "Action Recorder")
+	bool IsStreaming() const { return StreamWriter.IsValid() && StreamWriter->IsOpen(); }
+
 	/** Get elapsed recording time */
 	UFUNCTION(BlueprintCallable, Category = "Action Recorder")
 	float GetRecordingTime() const { return RecordingTime; }
@@ -165,7 +180,11 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Recording Settings")
 	float MaxRecordingDuration;
 
-	/** Maximum number of actions to keep in buffer */
+	/**
+	 * Maximum number of actions to keep in buffer (0 = unlimited, the default); the oldest are dropped
+	 * beyond it, so SaveRecording only writes the most recent ones. With a stream file the buffer is a
+	 * recent window and the file holds the whole recording.
+	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Recording Settings")
 	int32 RecordingBufferSize;
 
@@ -197,6 +216,14 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Recording Settings")
 	float RotationThreshold;
 
+	/** Binary timeline file (.adtb) actions are streamed to while recording (empty = memory only) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Recording Settings")
+	FString StreamFilePath;
+
+	/** Append to an existing recording at StreamFilePath instead of replacing it */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Recording Settings")
+	bool bResumeStreamFile;
+
 private:
 	/** Cached pawn reference */
 	UPROPERTY()
@@ -215,6 +242,12 @@ private:
 	/** Time since last action was recorded */
 	float TimeSinceLastAction;
 
+	/** Writer for StreamFilePath while recording */
+	TUniquePtr<FTimelineStreamWriter> StreamWriter;
+
+	/** Whether this recording has already warned about dropping actions */
+	bool bWarnedBufferTrim;
+
 	/** Initialize component references */
 	void InitializeReferences();
 
@@ -227,6 +260,12 @@ private:
 	/** Check and record rotation changes */
 	void CheckRotationChanges();
 
+	/** Stream a newly recorded action and broadcast it */
+	void CommitAction(const FRecordedAction& Action);
+
+	/** Finish the stream file, if any */
+	void CloseStream();
+
 	/** Apply buffer size limit */
 	void EnforceBufferLimit();
 
@@ -5,8 +5,18 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "AutoDriver/AutoDriverTypes.h"
+#include "AutoDriver/AutoDriverUITypes.h"
+#include "Misc/TVariant.h"
 #include "ActionTimeline.generated.h"
 
+/**
+ * Decoded parameters of a built-in action type (Movement, Rotation, Input, UIClick).
+ * Timelines keep these in memory instead of JSON, so neither recording nor playback
+ * builds or parses JSON; it is only produced and parsed on export and import.
+ * Custom actions carry no payload (FEmptyVariantState) and keep their ActionData string.
+ */
+using FRecordedActionPayload = TVariant<FEmptyVariantState, FAutoDriverMoveParams, FAutoDriverRotateParams, FAutoDriverInputParams, FUIClickParams>;
+
 /**
  * Represents a single recorded action at a specific timestamp
  */
@@ -27,7 +37,10 @@ struct YESUEFSD_API FRecordedAction
 	UPROPERTY(BlueprintReadWrite, Category = "Recording")
 	FString ActionName;
 
-	/** Serialized action data in JSON format */
+	/**
+	 * Serialized action data in JSON format. Empty for built-in action types held in a timeline,
+	 * whose parameters live in Payload; see UActionTimeline::GetActionDataJSON.
+	 */
 	UPROPERTY(BlueprintReadWrite, Category = "Recording")
 	FString ActionData;
 
@@ -35,6 +48,12 @@ struct YESUEFSD_API FRecordedAction
 	UPROPERTY(BlueprintReadWrite, Category = "Recording")
 	TMap<FString, FString> Metadata;
 
+	/**
+	 * Typed parameters of built-in action types. Not reflected: Serialize writes it after the
+	 * properties (so duplication and saving keep it), and JSON export encodes it as ActionData.
+	 */
+	FRecordedActionPayload Payload;
+
 	FRecordedAction()
 		: Timestamp(0.0f)
 	{
@@ -47,6 +66,26 @@ struct YESUEFSD_API FRecordedAction
 		, ActionData(InActionData)
 	{
 	}
+
+	FRecordedAction(float InTimestamp, const FString& InActionType, const FString& InActionName, FRecordedActionPayload&& InPayload)
+		: Timestamp(InTimestamp)
+		, ActionType(InActionType)
+		, ActionName(InActionName)
+		, Payload(MoveTemp(InPayload))
+	{
+	}
+
+	/** Serialize the reflected properties followed by the payload */
+	bool Serialize(FArchive& Ar);
+};
+
+template<>
+struct TStructOpsTypeTraits<FRecordedAction> : public TStructOpsTypeTraitsBase2<FRecordedAction>
+{
+	enum
+	{
+		WithSerializer = true,
+	};
 };
 
 /**
@@ -111,10 +150,22 @@ public:
 
 	// Action Management
 
-	/** Add an action to the timeline */
+	/**
+	 * Add an action to the timeline. Appending in time order is O(1); an earlier timestamp is
+	 * inserted at its place by binary search (after any actions with the same timestamp).
+	 * ActionData JSON of a built-in action type is decoded into the typed payload here.
+	 */
 	UFUNCTION(BlueprintCallable, Category = "Action Timeline")
 	void AddAction(const FRecordedAction& Action);
 
+	/** Action data of an action as JSON, encoding the typed payload of built-in action types */
+	UFUNCTION(BlueprintPure, Category = "Action Timeline")
+	static FString GetActionDataJSON(const FRecordedAction& Action);
+
+	/** Remove the Count earliest actions */
+	UFUNCTION(BlueprintCallable, Category = "Action Timeline")
+	void RemoveOldestActions(int32 Count);
+
 	/** Add a movement action */
 	UFUNCTION(BlueprintCallable, Category = "Action Timeline")
 	void AddMovementAction(float Timestamp, const FVector& TargetLocation, const FAutoDriverMoveParams& Params);
@@ -159,7 +210,7 @@ public:
 
 	// Timeline Properties
 
-	/** Get total duration of the timeline */
+	/** Get total duration of the timeline (timestamp of the last action) */
 	UFUNCTION(BlueprintCallable, Category = "Action Timeline")
 	float GetDuration() const;
 
@@ -181,14 +232,32 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Action Timeline")
 	bool ImportFromJSON(const FString& JSONString);
 
-	/** Save timeline to file */
+	/** Export timeline in the binary format (see TimelineBinaryFormat.h) */
+	void ExportToBinary(TArray<uint8>& OutData) const;
+
+	/**
+	 * Import timeline from the binary format. A file cut short (e.g. by a crash while recording)
+	 * loads up to its last complete chunk.
+	 */
+	bool ImportFromBinary(TConstArrayView<uint8> Data);
+
+	/** Save timeline to file; a .adtb path selects the binary format, anything else JSON */
 	UFUNCTION(BlueprintCallable, Category = "Action Timeline")
 	bool SaveToFile(const FString& FilePath);
 
-	/** Load timeline from file */
+	/** Load timeline from file; a .adtb path selects the binary format, anything else JSON */
 	UFUNCTION(BlueprintCallable, Category = "Action Timeline")
 	bool LoadFromFile(const FString& FilePath);
 
+	/** Actions per chunk when exporting to the binary format */
+	static constexpr int32 ActionsPerBinaryChunk = 4096;
+
+	/**
+	 * Decode the ActionData JSON of a built-in action type into its payload, clearing ActionData
+	 * @return False if the type is not built in or the data does not parse (the action is left as is)
+	 */
+	static bool DecodeActionData(FRecordedAction& Action);
+
 	// Compression & Optimization
 
 	/** Remove duplicate consecutive actions */
@@ -208,9 +277,12 @@ protected:
 	UPROPERTY()
 	FRecordingMetadata Metadata;
 
-	/** Helper to update metadata after modifications */
+	/** Insert an action at its place in time order */
+	void InsertAction(FRecordedAction&& Action);
+
+	/** Helper to update metadata after modifications; O(1) */
 	void UpdateMetadata();
 
-	/** Sort actions by timestamp */
+	/** Sort actions by timestamp (stable; skipped when already sorted) */
 	void SortActions();
 };
@@ -0,0 +1,73 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Recording/TimelineBinaryFormat.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Memory-Mapped Timeline
+ *
+ * Read-only view of a binary timeline file (.adtb) for playing long recordings without
+ * loading them. The file is memory-mapped. Opening reads only the chunk headers (plus the
+ * small metadata chunks) and builds a chunk index with each chunk's time range. Actions are
+ * decoded one chunk at a time on request, so heap use is one chunk's actions however long
+ * the recording is. Mapped pages are file-backed and can be dropped by the OS at any time.
+ *
+ * Each chunk's CRC is checked when it is decoded rather than on open, so opening does not
+ * read the whole file. A file cut short opens up to its last complete chunk.
+ *
+ * Immutable after Open; decoding is const and safe from several threads.
+ */
+class YESUEFSD_API FMappedTimeline
+{
+public:
+	~FMappedTimeline();
+
+	/**
+	 * Map and index a binary timeline
+	 * @return Null if the file cannot be mapped, is not a binary timeline, or its chunks are out of time order
+	 */
+	static TUniquePtr<FMappedTimeline> Open(const FString& FilePath);
+
+	const FRecordingMetadata& GetMetadata() const { return Metadata; }
+
+	/** Timestamp of the last action */
+	float GetDuration() const { return Metadata.Duration; }
+
+	int64 GetActionCount() const { return ActionCount; }
+
+	int32 GetNumChunks() const { return Chunks.Num(); }
+
+	const TimelineBinary::FChunkHeader& GetChunkHeader(int32 ChunkIndex) const { return Chunks[ChunkIndex].Header; }
+
+	/**
+	 * First chunk with an action later than Time, found by binary search over the chunk index
+	 * @return GetNumChunks() if every action is at or before Time
+	 */
+	int32 FindChunkAfter(float Time) const;
+
+	/**
+	 * Decode the actions of a chunk, replacing the contents of OutActions
+	 * @return False if the chunk is corrupt (OutActions is left empty)
+	 */
+	bool DecodeChunk(int32 ChunkIndex, TArray<FRecordedAction>& OutActions) const;
+
+private:
+	FMappedTimeline() = default;
+
+	TUniquePtr<IMappedFileHandle> FileHandle;
+	TUniquePtr<IMappedFileRegion> Region;
+	TConstArrayView<uint8> Data;
+
+	TimelineBinary::FFileHeader FileHeader;
+
+	/** Actions chunks in file (and time) order */
+	TArray<TimelineBinary::FChunkLocation> Chunks;
+
+	FRecordingMetadata Metadata;
+	int64 ActionCount = 0;
+};
@@ -0,0 +1,164 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Recording/ActionTimeline.h"
+
+/**
+ * Binary Timeline Format (.adtb)
+ *
+ * Compact, versioned alternative to the JSON timeline format. A file is a fixed header
+ * followed by a sequence of self-contained chunks:
+ *
+ *   File header   Magic "ADTB", version, position and angle quantization steps
+ *   Chunk         Header (magic "ADTC", type, payload size, action count, first/last
+ *                 timestamp, CRC of the other header fields and the payload) followed
+ *                 by the payload
+ *
+ * A metadata chunk holds the recording metadata (the last one in the file wins). An actions
+ * chunk holds a run of actions in time order: an interned name table (action types, names,
+ * input names and per-action metadata strings used by the chunk), then one record per action.
+ * Timestamps are stored as varint deltas of their order-preserving float bits, so they are
+ * exact. Locations and rotations are quantized by the steps in the file header and stored as
+ * zigzag varint deltas from the previous action of the same kind; other parameters are kept
+ * as raw floats.
+ *
+ * Every chunk decodes on its own (delta state restarts at each chunk), and a torn or corrupt
+ * chunk is detected by its size and CRC, so a file can be read up to its last complete chunk
+ * and seeked chunk by chunk. Header fields are sanity-checked on their own as well (an action
+ * takes at least one payload byte, timestamps are ordered), so a header read without its
+ * payload never yields counts or times the file cannot hold.
+ *
+ * Duration and action count are not stored; they follow from the actions.
+ */
+namespace TimelineBinary
+{
+	/** "ADTB" */
+	constexpr uint32 FileMagic = 0x42544441;
+	/** "ADTC" */
+	constexpr uint32 ChunkMagic = 0x43544441;
+	constexpr uint32 FileVersion = 1;
+	/** Oldest version read */
+	constexpr uint32 MinFileVersion = 1;
+
+	/** Default location quantization step (cm) */
+	constexpr float DefaultPositionStep = 0.1f;
+	/** Default rotation quantization step (degrees) */
+	constexpr float DefaultAngleStep = 0.01f;
+
+	/** Extension that selects the binary format in SaveToFile / LoadFromFile */
+	YESUEFSD_API extern const TCHAR* const FileExtension;
+
+	/** True if the path has the binary timeline extension */
+	YESUEFSD_API bool IsBinaryPath(const FString& FilePath);
+
+	enum class EChunkType : uint32
+	{
+		Metadata = 1,
+		Actions = 2,
+	};
+
+	struct FFileHeader
+	{
+		static constexpr int32 Size = 16;
+
+		uint32 Magic = FileMagic;
+		uint32 Version = FileVersion;
+		float PositionStep = DefaultPositionStep;
+		float AngleStep = DefaultAngleStep;
+	};
+
+	struct FChunkHeader
+	{
+		static constexpr int32 Size = 28;
+
+		uint32 Magic = ChunkMagic;
+		EChunkType Type = EChunkType::Actions;
+		uint32 PayloadSize = 0;
+		uint32 ActionCount = 0;
+		float FirstTimestamp = 0.0f;
+		float LastTimestamp = 0.0f;
+		/** CRC32 of the fields above (except Magic) followed by the payload */
+		uint32 Crc = 0;
+	};
+
+	/** A complete chunk found in a file */
+	struct FChunkLocation
+	{
+		FChunkHeader Header;
+		/** Byte offset of the payload from the start of the file */
+		int64 PayloadOffset = 0;
+	};
+
+	YESUEFSD_API void WriteFileHeader(const FFileHeader& Header, TArray<uint8>& OutData);
+
+	/** Parse and validate the file header; false if it is not a supported binary timeline */
+	YESUEFSD_API bool ReadFileHeader(TConstArrayView<uint8> Data, FFileHeader& OutHeader);
+
+	/** Append a metadata chunk */
+	YESUEFSD_API void WriteMetadataChunk(const FRecordingMetadata& Metadata, TArray<uint8>& OutData);
+
+	/**
+	 * Read a metadata chunk's payload into Metadata (Duration and ActionCount are left alone)
+	 * @return False if the payload is malformed
+	 */
+	YESUEFSD_API bool ReadMetadata(TConstArrayView<uint8> Payload, FRecordingMetadata& Metadata);
+
+	/**
+	 * Locate the complete chunks after the file header. Stops at the first torn or corrupt chunk,
+	 * or at a header whose fields are implausible.
+	 * @param OutValidSize Bytes from the start of the file up to the end of the last complete chunk
+	 * @param bVerifyPayloads Check each chunk's CRC. Without it only headers are read (cheap on
+	 *        a mapped file), and chunks should go through VerifyChunk before they are decoded.
+	 */
+	YESUEFSD_API void ScanChunks(TConstArrayView<uint8> Data, TArray<FChunkLocation>& OutChunks, int64& OutValidSize, bool bVerifyPayloads = true);
+
+	/** True if a chunk's header fields and payload match its CRC */
+	YESUEFSD_API bool VerifyChunk(const FChunkHeader& Header, TConstArrayView<uint8> Payload);
+
+	/**
+	 * Decode the actions of an actions chunk, appending them to OutActions
+	 * @return False if the payload is malformed (OutActions is left as it was)
+	 */
+	YESUEFSD_API bool ReadActions(const FFileHeader& FileHeader, const FChunkHeader& ChunkHeader, TConstArrayView<uint8> Payload, TArray<FRecordedAction>& OutActions);
+
+	/**
+	 * Builds one actions chunk at a time. Add actions in time order, then Seal to append the
+	 * chunk to a buffer; the encoder is then ready for the next chunk.
+	 */
+	class YESUEFSD_API FChunkEncoder
+	{
+	public:
+		explicit FChunkEncoder(const FFileHeader& InFileHeader);
+
+		void Add(const FRecordedAction& Action);
+
+		int32 GetNumActions() const { return NumActions; }
+
+		/** Encoded size of the actions added so far, without the name table */
+		int32 GetEncodedSize() const { return Records.Num(); }
+
+		/** Append the chunk (header, name table, records) to OutData and reset; no-op if empty */
+		void Seal(TArray<uint8>& OutData);
+
+	private:
+		/** Index of a string in this chunk's name table */
+		uint32 Intern(const FString& Name);
+
+		float PositionStep;
+		float AngleStep;
+
+		TArray<FString> Names;
+		TMap<FString, uint32> NameIndices;
+		TArray<uint8> Records;
+		int32 NumActions = 0;
+		float FirstTimestamp = 0.0f;
+		float LastTimestamp = 0.0f;
+
+		/** Delta state, restarted at every chunk */
+		uint32 PreviousTimeBits = 0;
+		FInt64Vector PreviousLocation = FInt64Vector::ZeroValue;
+		FInt64Vector PreviousRotation = FInt64Vector::ZeroValue;
+	};
+}
@@ -0,0 +1,113 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Recording/TimelineBinaryFormat.h"
+#include "Tasks/Pipe.h"
+#include <atomic>
+
+class IFileHandle;
+
+/**
+ * Streaming Timeline Writer
+ *
+ * Appends actions to a binary timeline file (.adtb) while they are recorded. Actions are
+ * gathered into a chunk on the calling thread. The chunk is sealed once it holds
+ * MaxActionsPerChunk actions or spans MaxChunkSeconds of recording time; the owner calls
+ * Tick with the recording time so a chunk is also sealed when no further action arrives.
+ * Sealed chunks are written and flushed to disk in order on a background task.
+ *
+ * A crash therefore loses at most MaxChunkSeconds of actions plus whatever was still queued.
+ * Each chunk carries its size and CRC, so a torn final chunk is detected. Readers (and Open
+ * with bResume) keep everything before it.
+ *
+ * Memory is bounded: if more than MaxPendingBytes of sealed chunks are waiting for the disk,
+ * Add blocks until the backlog has been written.
+ *
+ * Resuming scans the existing file through a memory-mapped view rather than loading it.
+ *
+ * Add, Tick, Flush and Close must be called from one thread (the game thread for the recorder).
+ */
+class YESUEFSD_API FTimelineStreamWriter
+{
+public:
+	/** Actions after which the current chunk is sealed */
+	static constexpr int32 MaxActionsPerChunk = 1024;
+
+	/** Recording time after which the current chunk is sealed (seconds) */
+	static constexpr float MaxChunkSeconds = 1.0f;
+
+	/** Sealed bytes allowed to wait for the disk before Add blocks */
+	static constexpr int64 MaxPendingBytes = 4 * 1024 * 1024;
+
+	FTimelineStreamWriter();
+	~FTimelineStreamWriter();
+
+	FTimelineStreamWriter(const FTimelineStreamWriter&) = delete;
+	FTimelineStreamWriter& operator=(const FTimelineStreamWriter&) = delete;
+
+	/**
+	 * Open a file for streaming and append a metadata chunk
+	 * @param bResume Keep an existing recording at FilePath and append to it. The file is cut
+	 *        back to its last complete chunk first. Otherwise the file is replaced.
+	 * @return False if the file cannot be opened, or bResume finds a file that is not a binary timeline
+	 */
+	bool Open(const FString& FilePath, const FRecordingMetadata& Metadata, bool bResume = false);
+
+	/** Queue an action; actions must be added in time order */
+	void Add(const FRecordedAction& Action);
+
+	/** Seal the current chunk if it is MaxChunkSeconds old at RecordingTime, even though no action arrived since */
+	void Tick(float RecordingTime);
+
+	/** Seal the current chunk and queue it for writing, without waiting for it */
+	void Flush();
+
+	/** Write the remaining actions and a final metadata chunk, then close the file (waits for the disk) */
+	void Close(const FRecordingMetadata& Metadata);
+
+	bool IsOpen() const { return FileHandle.IsValid(); }
+
+	/** True once a background write has failed; later chunks are dropped */
+	bool HasWriteError() const { return bWriteError.load(std::memory_order_relaxed); }
+
+	/** Timestamp of the last action already in the file when it was resumed (0 for a new file) */
+	float GetResumeTimestamp() const { return ResumeTimestamp; }
+
+	/** Actions added since Open */
+	int64 GetNumActions() const { return NumActions; }
+
+	const FString& GetFilePath() const { return FilePath; }
+
+private:
+	/** Queue bytes for the background writer */
+	void Enqueue(TArray<uint8>&& Data);
+
+	/** Block until every queued write is done */
+	void WaitForWrites();
+
+	/**
+	 * Read the header and find the complete chunks of an existing file through a mapped view
+	 * @return False if the file cannot be mapped or is not a binary timeline
+	 */
+	bool ScanExisting(const FString& InFilePath, int64& OutValidSize);
+
+	FString FilePath;
+	TimelineBinary::FFileHeader FileHeader;
+	TimelineBinary::FChunkEncoder Encoder;
+
+	/** Owned by the write tasks between Open and Close */
+	TUniquePtr<IFileHandle> FileHandle;
+
+	/** Writes run in order on this pipe */
+	UE::Tasks::FPipe WritePipe;
+	UE::Tasks::FTask LastWrite;
+
+	std::atomic<int64> PendingBytes;
+	std::atomic<bool> bWriteError;
+
+	float ChunkStartTimestamp = 0.0f;
+	float ResumeTimestamp = 0.0f;
+	int64 NumActions = 0;
+};
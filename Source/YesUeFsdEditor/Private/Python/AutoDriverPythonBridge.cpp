@@ -2,6 +2,7 @@
 
 #include "Python/AutoDriverPythonBridge.h"
 #include "AutoDriver/AutoDriverComponent.h"
+#include "AutoDriver/NavigationHelper.h"
 #include "AutoDriver/AutoDriverSubsystem.h"
 #include "AutoDriver/AutoDriverUITypes.h"
 #include "AutoDriver/WidgetQueryHelper.h"
@@ -161,6 +162,37 @@ float UAutoDriverPythonBridge::GetPathLength(FVector From, FVector To, int32 Pla
 	return AutoDriver->GetPathLengthToLocation(To);
 }
 
+int32 UAutoDriverPythonBridge::FindNearestByPathLength(FVector From, const TArray<FVector>& Targets, float& OutPathLength, int32 PlayerIndex)
+{
+	OutPathLength = -1.0f;
+
+	UAutoDriverComponent* AutoDriver = GetAutoDriverForPlayer(PlayerIndex);
+	if (!AutoDriver)
+	{
+		return -1;
+	}
+
+	int32 TargetIndex = INDEX_NONE;
+	const FNavigationQueryResult Result = UNavigationHelper::FindNearestByPathLength(AutoDriver, From, Targets, TargetIndex);
+	if (Result.bSuccess)
+	{
+		OutPathLength = Result.PathLength;
+	}
+	return TargetIndex;
+}
+
+float UAutoDriverPythonBridge::EstimatePathLength(FVector From, FVector To, bool bRefine, int32 PlayerIndex)
+{
+	UAutoDriverComponent* AutoDriver = GetAutoDriverForPlayer(PlayerIndex);
+	if (!AutoDriver)
+	{
+		return -1.0f;
+	}
+
+	const FNavigationQueryResult Result = UNavigationHelper::EstimatePathLength(AutoDriver, From, To, bRefine);
+	return Result.bSuccess ? Result.PathLength : -1.0f;
+}
+
 FVector UAutoDriverPythonBridge::GetRandomReachableLocation(FVector Origin, float Radius, int32 PlayerIndex)
 {
 	UAutoDriverComponent* AutoDriver = GetAutoDriverForPlayer(PlayerIndex);
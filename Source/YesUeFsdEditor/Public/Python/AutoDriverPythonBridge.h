@@ -80,6 +80,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Python|AutoDriver")
 	static float GetPathLength(FVector From, FVector To, int32 PlayerIndex = 0);
 
+	/** Get the index of the target with the shortest path from a location (-1 if none is reachable) */
+	UFUNCTION(BlueprintCallable, Category = "Python|AutoDriver")
+	static int32 FindNearestByPathLength(FVector From, const TArray<FVector>& Targets, float& OutPathLength, int32 PlayerIndex = 0);
+
+	/** Estimate path length on the navmesh cluster graph; exact when bRefine is set (-1 if unreachable) */
+	UFUNCTION(BlueprintCallable, Category = "Python|AutoDriver")
+	static float EstimatePathLength(FVector From, FVector To, bool bRefine = false, int32 PlayerIndex = 0);
+
 	/** Get random reachable location */
 	UFUNCTION(BlueprintCallable, Category = "Python|AutoDriver")
 	static FVector GetRandomReachableLocation(FVector Origin, float Radius, int32 PlayerIndex = 0);